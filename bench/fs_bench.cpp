@@ -0,0 +1,446 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   fs_bench.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+#include "staticlib/json.hpp"
+#include "staticlib/support.hpp"
+#include "staticlib/tinydir.hpp"
+
+#include "wilton/wilton.h"
+
+#include "wilton/support/buffer.hpp"
+
+#include "file_stat.hpp"
+
+namespace wilton {
+namespace fs {
+
+// defined in wiltoncall_fs.cpp
+support::buffer append_tl_file_writer(sl::io::span<const char> data);
+support::buffer close_tl_file_writer(sl::io::span<const char> data);
+support::buffer close_writer(sl::io::span<const char> data);
+support::buffer copy_file(sl::io::span<const char> data);
+support::buffer insert_file(sl::io::span<const char> data);
+support::buffer open_tl_file_writer(sl::io::span<const char> data);
+support::buffer open_writer(sl::io::span<const char> data);
+support::buffer read_file(sl::io::span<const char> data);
+support::buffer read_lines(sl::io::span<const char> data);
+support::buffer readdir(sl::io::span<const char> data);
+support::buffer stat(sl::io::span<const char> data);
+support::buffer unlink(sl::io::span<const char> data);
+support::buffer write(sl::io::span<const char> data);
+
+} // namespace
+}
+
+namespace { // anonymous
+
+std::atomic<uint64_t> allocations_count(0);
+
+} // namespace
+
+// all heap allocations made with new, wilton buffers
+// returned from calls are allocated with malloc and are not counted
+void* operator new(std::size_t size) {
+    allocations_count.fetch_add(1, std::memory_order_relaxed);
+    auto ptr = std::malloc(0 != size ? size : 1);
+    if (nullptr == ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) STATICLIB_NOEXCEPT {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) STATICLIB_NOEXCEPT {
+    std::free(ptr);
+}
+
+namespace { // anonymous
+
+namespace fs = wilton::fs;
+namespace support = wilton::support;
+
+typedef support::buffer(*handler_fun)(sl::io::span<const char>);
+
+const uint64_t kb = 1024;
+const uint64_t mb = 1024 * kb;
+const uint64_t gb = 1024 * mb;
+// number of calls is chosen to process this amount of data
+const uint64_t bytes_per_bench = 256 * mb;
+const size_t min_calls = 3;
+const size_t max_calls = 1000;
+const size_t tree_file_size = 128;
+
+// prevents the optimizer from dropping benchmarked calls
+volatile size_t sink_counter = 0;
+
+struct file_fixture {
+    std::string label;
+    std::string path;
+    uint64_t size;
+};
+
+struct tree_fixture {
+    std::string label;
+    std::string dir;
+    std::vector<std::string> files;
+};
+
+std::string json_string(const std::string& str) {
+    auto res = std::string("\"");
+    for (char ch : str) {
+        auto uch = static_cast<unsigned char>(ch);
+        if ('"' == ch || '\\' == ch) {
+            res.push_back('\\');
+            res.push_back(ch);
+        } else if (uch < 0x20) {
+            char esc[8];
+            std::snprintf(esc, sizeof(esc), "\\u%04x", static_cast<unsigned int>(uch));
+            res.append(esc);
+        } else {
+            res.push_back(ch);
+        }
+    }
+    res.push_back('"');
+    return res;
+}
+
+size_t call(handler_fun fun, const std::string& input) {
+    auto buf = fun({input.data(), input.length()});
+    if (nullptr == buf.data()) {
+        return 0;
+    }
+    auto size = buf.size();
+    wilton_free(buf.data());
+    return size;
+}
+
+sl::json::value call_json(handler_fun fun, const std::string& input) {
+    auto buf = fun({input.data(), input.length()});
+    if (nullptr == buf.data()) {
+        return sl::json::value();
+    }
+    auto deferred = sl::support::defer([buf]() STATICLIB_NOEXCEPT {
+        wilton_free(buf.data());
+    });
+    return sl::json::load({buf.data(), buf.size()});
+}
+
+uint64_t nanos_since(std::chrono::steady_clock::time_point start) {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+uint64_t percentile(const std::vector<uint64_t>& sorted, double quantile) {
+    auto idx = static_cast<size_t>(quantile * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+// one warm-up call is not measured, fixtures are expected to be in page cache
+void report(const std::string& name, uint64_t bytes_per_call, size_t calls, const std::function<void()>& fun) {
+    try {
+        fun();
+        auto latencies = std::vector<uint64_t>();
+        latencies.reserve(calls);
+        auto allocs_before = allocations_count.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < calls; i++) {
+            auto call_start = std::chrono::steady_clock::now();
+            fun();
+            latencies.push_back(nanos_since(call_start));
+        }
+        auto total_nanos = nanos_since(start);
+        auto allocs = allocations_count.load(std::memory_order_relaxed) - allocs_before;
+        std::sort(latencies.begin(), latencies.end());
+        auto secs = static_cast<double>(std::max(total_nanos, static_cast<uint64_t>(1))) / 1e9;
+        std::printf("{\"bench\": \"%s\", \"bytes\": %llu, \"calls\": %lu, \"gbPerSec\": %.3f, \"callsPerSec\": %.1f,"
+                " \"p50Nanos\": %llu, \"p99Nanos\": %llu, \"allocsPerCall\": %.1f}\n",
+                name.c_str(), static_cast<unsigned long long>(bytes_per_call), static_cast<unsigned long>(calls),
+                static_cast<double>(bytes_per_call * calls) / secs / 1e9,
+                static_cast<double>(calls) / secs,
+                static_cast<unsigned long long>(percentile(latencies, 0.5)),
+                static_cast<unsigned long long>(percentile(latencies, 0.99)),
+                static_cast<double>(allocs) / static_cast<double>(calls));
+    } catch (const std::exception& e) {
+        std::printf("{\"bench\": \"%s\", \"error\": %s}\n", name.c_str(), json_string(e.what()).c_str());
+    }
+    std::fflush(stdout);
+}
+
+bool file_exists(const std::string& path, uint64_t size) {
+    auto st = fs::file_stat();
+    return fs::stat_path(path, true, st) && fs::entry_type::file == st.type && size == st.size;
+}
+
+std::string make_chunk(size_t size) {
+    auto res = std::string();
+    res.reserve(size);
+    const std::string line = "2026-10-16 12:00:00.000 INFO wilton.fs request processed, path: [/var/data/file.txt]\n";
+    while (res.length() < size) {
+        res.append(line, 0, std::min(line.length(), size - res.length()));
+    }
+    return res;
+}
+
+// existing fixtures of the same size are reused
+void write_fixture(const std::string& path, uint64_t size) {
+    if (file_exists(path, size)) {
+        return;
+    }
+    auto chunk = make_chunk(static_cast<size_t>(std::min(size, 4 * mb)));
+    auto sink = sl::tinydir::file_sink(path);
+    uint64_t written = 0;
+    while (written < size) {
+        auto len = static_cast<size_t>(std::min(size - written, static_cast<uint64_t>(chunk.length())));
+        sl::io::write_all(sink, {chunk.data(), len});
+        written += len;
+    }
+}
+
+void ensure_dir(const std::string& dir) {
+    if (!sl::tinydir::path(dir).exists()) {
+        sl::tinydir::create_directory(dir);
+    }
+}
+
+std::vector<file_fixture> make_file_fixtures(const std::string& work_dir, uint64_t max_size) {
+    auto all = std::vector<file_fixture>{
+        { "1kb", "", kb },
+        { "64kb", "", 64 * kb },
+        { "1mb", "", mb },
+        { "16mb", "", 16 * mb },
+        { "256mb", "", 256 * mb },
+        { "1gb", "", gb },
+        { "4gb", "", 4 * gb }
+    };
+    auto res = std::vector<file_fixture>();
+    for (auto& fx : all) {
+        if (fx.size > max_size) {
+            break;
+        }
+        fx.path = work_dir + "/file_" + fx.label + ".txt";
+        write_fixture(fx.path, fx.size);
+        res.push_back(fx);
+    }
+    return res;
+}
+
+tree_fixture make_tree_fixture(const std::string& work_dir, size_t count) {
+    auto label = sl::support::to_string(count);
+    auto res = tree_fixture{label, work_dir + "/tree_" + label, std::vector<std::string>()};
+    ensure_dir(res.dir);
+    for (size_t i = 0; i < count; i++) {
+        auto path = res.dir + "/entry_" + sl::support::to_string(i) + ".txt";
+        write_fixture(path, tree_file_size);
+        res.files.push_back(std::move(path));
+    }
+    return res;
+}
+
+size_t calls_for_bytes(uint64_t bytes_per_call) {
+    auto calls = static_cast<size_t>(std::min(bytes_per_bench / std::max(bytes_per_call, static_cast<uint64_t>(1)),
+            static_cast<uint64_t>(max_calls)));
+    return std::max(calls, min_calls);
+}
+
+void bench_read(const std::vector<file_fixture>& files) {
+    for (auto& fx : files) {
+        auto calls = calls_for_bytes(fx.size);
+        // in-memory results are limited to 2GB
+        if (fx.size <= gb) {
+            auto text = sl::json::value({
+                { "path", fx.path }
+            }).dumps();
+            report("read_file_text_" + fx.label, fx.size, calls, [&text] {
+                sink_counter += call(fs::read_file, text);
+            });
+        }
+        if (fx.size <= 256 * mb) {
+            auto hex = sl::json::value({
+                { "path", fx.path },
+                { "hex", true }
+            }).dumps();
+            report("read_file_hex_" + fx.label, fx.size, calls, [&hex] {
+                sink_counter += call(fs::read_file, hex);
+            });
+            auto lines = sl::json::value({
+                { "path", fx.path }
+            }).dumps();
+            report("read_lines_" + fx.label, fx.size, calls, [&lines] {
+                sink_counter += call(fs::read_lines, lines);
+            });
+        }
+    }
+}
+
+void bench_copy(const std::vector<file_fixture>& files) {
+    for (auto& fx : files) {
+        auto calls = calls_for_bytes(fx.size);
+        auto dest = fx.path + ".copy";
+        auto copy = sl::json::value({
+            { "oldPath", fx.path },
+            { "newPath", dest }
+        }).dumps();
+        report("copy_file_" + fx.label, fx.size, calls, [&copy] {
+            sink_counter += call(fs::copy_file, copy);
+        });
+        // destination of the copy above is overwritten in place
+        auto insert = sl::json::value({
+            { "sourcePath", fx.path },
+            { "destPath", dest },
+            { "offset", 0 }
+        }).dumps();
+        report("insert_file_" + fx.label, fx.size, calls, [&insert] {
+            sink_counter += call(fs::insert_file, insert);
+        });
+        auto remove = sl::json::value({
+            { "path", dest }
+        }).dumps();
+        try {
+            call(fs::unlink, remove);
+        } catch (const std::exception&) {
+            // copy may have failed
+        }
+    }
+}
+
+void bench_trees(const std::vector<tree_fixture>& trees) {
+    for (auto& tf : trees) {
+        auto list = sl::json::value({
+            { "path", tf.dir }
+        }).dumps();
+        report("readdir_" + tf.label, 0, calls_for_bytes(tf.files.size() * mb), [&list] {
+            sink_counter += call(fs::readdir, list);
+        });
+        auto list_stats = sl::json::value({
+            { "path", tf.dir },
+            { "withStats", true }
+        }).dumps();
+        report("readdir_stats_" + tf.label, 0, calls_for_bytes(tf.files.size() * mb), [&list_stats] {
+            sink_counter += call(fs::readdir, list_stats);
+        });
+        auto paths = std::vector<sl::json::value>();
+        for (auto& fi : tf.files) {
+            paths.emplace_back(fi);
+        }
+        auto stat_many = sl::json::value({
+            { "paths", std::move(paths) }
+        }).dumps();
+        report("stat_paths_" + tf.label, 0, calls_for_bytes(tf.files.size() * mb), [&stat_many] {
+            sink_counter += call(fs::stat, stat_many);
+        });
+    }
+    if (!trees.empty() && !trees.front().files.empty()) {
+        auto stat_one = sl::json::value({
+            { "path", trees.front().files.front() }
+        }).dumps();
+        report("stat_single", 0, max_calls, [&stat_one] {
+            sink_counter += call(fs::stat, stat_one);
+        });
+    }
+}
+
+void bench_writers(const std::string& work_dir) {
+    auto path = work_dir + "/writer.out";
+    for (size_t chunk_size : { 4 * kb, 64 * kb }) {
+        auto label = sl::support::to_string(chunk_size / kb) + "kb";
+        auto chunk = make_chunk(chunk_size);
+        auto calls = calls_for_bytes(chunk_size);
+        // handle-based writer, chunks are passed as json strings
+        try {
+            auto opened = call_json(fs::open_writer, sl::json::value({
+                { "path", path }
+            }).dumps());
+            auto handle = opened["writerHandle"].as_int64_or_throw("writerHandle");
+            auto input = sl::json::value({
+                { "writerHandle", handle },
+                { "data", chunk }
+            }).dumps();
+            report("writer_append_" + label, chunk_size, calls, [&input] {
+                sink_counter += call(fs::write, input);
+            });
+            call(fs::close_writer, sl::json::value({
+                { "writerHandle", handle }
+            }).dumps());
+        } catch (const std::exception& e) {
+            std::printf("{\"bench\": \"%s\", \"error\": %s}\n", ("writer_append_" + label).c_str(),
+                    json_string(e.what()).c_str());
+        }
+        // thread-local writer, chunks are passed as is
+        try {
+            call(fs::open_tl_file_writer, sl::json::value({
+                { "path", path }
+            }).dumps());
+            report("tl_writer_append_" + label, chunk_size, calls, [&chunk] {
+                sink_counter += call(fs::append_tl_file_writer, chunk);
+            });
+            call(fs::close_tl_file_writer, std::string());
+        } catch (const std::exception& e) {
+            std::printf("{\"bench\": \"%s\", \"error\": %s}\n", ("tl_writer_append_" + label).c_str(),
+                    json_string(e.what()).c_str());
+        }
+    }
+}
+
+} // namespace
+
+// usage: wilton_fs_bench [work_dir] [max_file_size_mb]
+int main(int argc, char** argv) {
+    auto work_dir = std::string(argc > 1 ? argv[1] : "wilton_fs_bench_work");
+    auto max_size = argc > 2 ? std::strtoull(argv[2], nullptr, 10) * mb : 4 * gb;
+    try {
+        ensure_dir(work_dir);
+        auto files = make_file_fixtures(work_dir, max_size);
+        auto trees = std::vector<tree_fixture>();
+        trees.push_back(make_tree_fixture(work_dir, 1000));
+        trees.push_back(make_tree_fixture(work_dir, 10000));
+        bench_read(files);
+        bench_copy(files);
+        bench_trees(trees);
+        bench_writers(work_dir);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   kernels_bench.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "utf8.h"
+
+#include "hex_simd.hpp"
+#include "utf8_simd.hpp"
+
+namespace { // anonymous
+
+const size_t input_size = 64 * 1024 * 1024;
+const int rounds = 5;
+
+// prevents the optimizer from dropping benchmarked calls
+volatile size_t sink_counter = 0;
+
+std::string make_ascii_text(size_t size) {
+    auto res = std::string();
+    res.reserve(size);
+    const std::string line = "2026-10-16 12:00:00.000 INFO wilton.fs request processed, path: [/var/data/file.txt]\n";
+    while (res.length() < size) {
+        res.append(line, 0, std::min(line.length(), size - res.length()));
+    }
+    return res;
+}
+
+std::string make_mixed_text(size_t size) {
+    auto res = std::string();
+    res.reserve(size);
+    const std::string line = "\xd0\x9f\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 mixed text \xe2\x82\xac 100 \xf0\x9f\x98\x80\n";
+    while (res.length() + line.length() <= size) {
+        res.append(line);
+    }
+    res.append(size - res.length(), 'x');
+    return res;
+}
+
+std::string make_invalid_text(size_t size) {
+    auto res = make_ascii_text(size);
+    for (size_t i = 1000; i < res.length(); i += 4096) {
+        res[i] = '\xff';
+    }
+    return res;
+}
+
+void report(const std::string& name, const std::string& input, const std::function<void()>& fun) {
+    double best = 0;
+    for (int i = 0; i < rounds; i++) {
+        auto start = std::chrono::steady_clock::now();
+        fun();
+        auto finish = std::chrono::steady_clock::now();
+        auto secs = std::chrono::duration<double>(finish - start).count();
+        auto gbps = static_cast<double>(input.length()) / secs / 1e9;
+        if (gbps > best) {
+            best = gbps;
+        }
+    }
+    std::printf("{\"bench\": \"%s\", \"bytes\": %lu, \"gbPerSec\": %.3f}\n",
+            name.c_str(), static_cast<unsigned long>(input.length()), best);
+}
+
+void bench_utf8(const std::string& label, const std::string& input) {
+    report("utf8_is_valid_utf8cpp_" + label, input, [&input] {
+        sink_counter += utf8::is_valid(input.begin(), input.end()) ? 1 : 0;
+    });
+    report("utf8_is_valid_simd_" + label, input, [&input] {
+        sink_counter += wilton::fs::utf8_is_valid(input.data(), input.length()) ? 1 : 0;
+    });
+    report("utf8_replace_invalid_utf8cpp_" + label, input, [&input] {
+        auto out = std::string();
+        utf8::replace_invalid(input.begin(), input.end(), std::back_inserter(out));
+        sink_counter += out.length();
+    });
+    report("utf8_replace_invalid_simd_" + label, input, [&input] {
+        auto out = std::string();
+        wilton::fs::utf8_replace_invalid(input.data(), input.length(), out);
+        sink_counter += out.length();
+    });
+}
+
+// per-byte transform, same approach as streaming hex source/sink
+void hex_encode_bytewise(const std::string& input, std::string& out) {
+    static const char symbols[] = "0123456789abcdef";
+    for (size_t i = 0; i < input.length(); i++) {
+        auto byte = static_cast<unsigned char>(input[i]);
+        out.push_back(symbols[byte >> 4]);
+        out.push_back(symbols[byte & 0x0f]);
+    }
+}
+
+void hex_decode_bytewise(const std::string& input, std::string& out) {
+    for (size_t i = 0; i + 1 < input.length(); i += 2) {
+        auto hi = std::stoi(input.substr(i, 1), nullptr, 16);
+        auto lo = std::stoi(input.substr(i + 1, 1), nullptr, 16);
+        out.push_back(static_cast<char>((hi << 4) | lo));
+    }
+}
+
+void bench_hex(const std::string& input) {
+    auto hex = std::string(input.length() * 2, '\0');
+    wilton::fs::hex_encode(input.data(), input.length(), std::addressof(hex.front()));
+    report("hex_encode_bytewise", input, [&input] {
+        auto out = std::string();
+        hex_encode_bytewise(input, out);
+        sink_counter += out.length();
+    });
+    auto encoded = std::string(input.length() * 2, '\0');
+    report("hex_encode_simd", input, [&input, &encoded] {
+        wilton::fs::hex_encode(input.data(), input.length(), std::addressof(encoded.front()));
+        sink_counter += static_cast<unsigned char>(encoded.back());
+    });
+    report("hex_decode_bytewise", hex, [&hex] {
+        auto out = std::string();
+        hex_decode_bytewise(hex, out);
+        sink_counter += out.length();
+    });
+    auto decoded = std::string(hex.length() / 2, '\0');
+    report("hex_decode_simd", hex, [&hex, &decoded] {
+        sink_counter += wilton::fs::hex_decode(hex.data(), hex.length(), std::addressof(decoded.front())) ? 1 : 0;
+    });
+}
+
+} // namespace
+
+int main() {
+    bench_utf8("ascii", make_ascii_text(input_size));
+    bench_utf8("mixed", make_mixed_text(input_size));
+    bench_utf8("invalid", make_invalid_text(input_size));
+    bench_hex(make_mixed_text(input_size));
+    return 0;
+}
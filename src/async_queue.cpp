@@ -0,0 +1,156 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   async_queue.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "async_queue.hpp"
+
+#include "staticlib/support.hpp"
+
+#include "wilton/support/exception.hpp"
+
+namespace wilton {
+namespace fs {
+
+async_queue::async_queue(std::shared_ptr<task_pool> pool) :
+pool(std::move(pool)),
+next_ticket(1),
+closed(false) { }
+
+int64_t async_queue::submit(std::function<sl::json::value(int64_t)> op) {
+    int64_t ticket = 0;
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        if (closed) throw support::exception(TRACEMSG(
+                "Operations queue is closed"));
+        ticket = next_ticket;
+        next_ticket += 1;
+        pending.insert(ticket);
+    }
+    // queue is kept alive by running tasks
+    auto self = shared_from_this();
+    pool->submit([self, ticket, op] {
+        auto skip = false;
+        {
+            std::lock_guard<std::mutex> guard{self->mutex};
+            skip = self->closed || self->discarded.count(ticket) > 0;
+            if (skip) {
+                self->pending.erase(ticket);
+                self->discarded.erase(ticket);
+            }
+        }
+        if (!skip) {
+            auto res = op(ticket);
+            std::lock_guard<std::mutex> guard{self->mutex};
+            self->pending.erase(ticket);
+            if (!self->closed && 0 == self->discarded.erase(ticket)) {
+                self->completed.emplace(ticket, std::move(res));
+            }
+        }
+        self->cv.notify_all();
+    });
+    return ticket;
+}
+
+std::vector<sl::json::value> async_queue::poll(size_t max_count) {
+    std::lock_guard<std::mutex> guard{mutex};
+    return take_completed(max_count);
+}
+
+std::vector<sl::json::value> async_queue::wait_any(size_t max_count, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock{mutex};
+    wait_for(lock, timeout, [this] {
+        // discarded tickets are always pending
+        return !completed.empty() || pending.size() == discarded.size() || closed;
+    });
+    return take_completed(max_count);
+}
+
+std::vector<sl::json::value> async_queue::wait_all(const std::vector<int64_t>& tickets,
+        std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock{mutex};
+    for (auto ti : tickets) {
+        if (0 == pending.count(ti) && 0 == completed.count(ti)) throw support::exception(TRACEMSG(
+                "Unknown ticket specified: [" + sl::support::to_string(ti) + "]"));
+    }
+    wait_for(lock, timeout, [this, &tickets] {
+        for (auto ti : tickets) {
+            if (pending.count(ti) > 0 && 0 == discarded.count(ti) && !closed) return false;
+        }
+        return true;
+    });
+    auto res = std::vector<sl::json::value>();
+    for (auto ti : tickets) {
+        auto it = completed.find(ti);
+        if (completed.end() != it) {
+            res.emplace_back(std::move(it->second));
+            completed.erase(it);
+        }
+    }
+    return res;
+}
+
+size_t async_queue::discard(const std::vector<int64_t>& tickets) {
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        for (auto ti : tickets) {
+            if (completed.erase(ti) > 0) {
+                count += 1;
+            } else if (pending.count(ti) > 0 && discarded.insert(ti).second) {
+                count += 1;
+            }
+        }
+    }
+    cv.notify_all();
+    return count;
+}
+
+void async_queue::close() {
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        closed = true;
+        completed.clear();
+    }
+    cv.notify_all();
+}
+
+std::vector<sl::json::value> async_queue::take_completed(size_t max_count) {
+    auto res = std::vector<sl::json::value>();
+    while (!completed.empty() && res.size() < max_count) {
+        auto it = completed.begin();
+        res.emplace_back(std::move(it->second));
+        completed.erase(it);
+    }
+    return res;
+}
+
+bool async_queue::wait_for(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout,
+        std::function<bool()> ready) {
+    if (std::chrono::milliseconds::max() == timeout) {
+        cv.wait(lock, ready);
+        return true;
+    }
+    return cv.wait_for(lock, timeout, ready);
+}
+
+} // namespace
+}
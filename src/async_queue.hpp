@@ -0,0 +1,134 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   async_queue.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_ASYNC_QUEUE_HPP
+#define WILTON_FS_ASYNC_QUEUE_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "staticlib/json.hpp"
+
+#include "task_pool.hpp"
+
+namespace wilton {
+namespace fs {
+
+/**
+ * Operations running on the task pool, identified by tickets;
+ * results are kept until collected, discarded or the queue is closed;
+ * each caller is expected to use its own queue, so completions are
+ * never taken by other callers; must be owned by `std::shared_ptr`
+ */
+class async_queue : public std::enable_shared_from_this<async_queue> {
+    std::shared_ptr<task_pool> pool;
+    std::mutex mutex;
+    std::condition_variable cv;
+    int64_t next_ticket;
+    std::set<int64_t> pending;
+    std::map<int64_t, sl::json::value> completed;
+    // pending operations, not started ones are skipped, results of running ones are dropped
+    std::set<int64_t> discarded;
+    bool closed;
+
+public:
+    explicit async_queue(std::shared_ptr<task_pool> pool);
+
+    async_queue(const async_queue&) = delete;
+
+    async_queue& operator=(const async_queue&) = delete;
+
+    /**
+     * Enqueues an operation, it must not throw
+     *
+     * @param op operation, receives its ticket
+     * @return ticket
+     */
+    int64_t submit(std::function<sl::json::value(int64_t)> op);
+
+    /**
+     * Takes completed results without waiting
+     *
+     * @param max_count max number of results to take
+     * @return results in tickets order
+     */
+    std::vector<sl::json::value> poll(size_t max_count);
+
+    /**
+     * Waits for at least one completion and takes completed results,
+     * returns immediately when no operations are pending
+     *
+     * @param max_count max number of results to take
+     * @param timeout max wait time, zero to return immediately,
+     *        `std::chrono::milliseconds::max()` for no limit
+     * @return results, empty on timeout
+     */
+    std::vector<sl::json::value> wait_any(size_t max_count, std::chrono::milliseconds timeout);
+
+    /**
+     * Waits for the specified tickets and takes their results,
+     * tickets that are not known to the queue are reported with
+     * an exception
+     *
+     * @param tickets tickets to wait for
+     * @param timeout max wait time, zero to return immediately,
+     *        `std::chrono::milliseconds::max()` for no limit
+     * @return results of tickets completed before timeout
+     */
+    std::vector<sl::json::value> wait_all(const std::vector<int64_t>& tickets,
+            std::chrono::milliseconds timeout);
+
+    /**
+     * Drops results of the specified tickets, operations that
+     * have not started yet are not run; unknown tickets are ignored
+     *
+     * @param tickets tickets to discard
+     * @return number of discarded tickets
+     */
+    size_t discard(const std::vector<int64_t>& tickets);
+
+    /**
+     * Discards all operations and results, further submits are rejected;
+     * running operations are completed on the pool
+     */
+    void close();
+
+private:
+    std::vector<sl::json::value> take_completed(size_t max_count);
+
+    bool wait_for(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds timeout,
+            std::function<bool()> ready);
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_ASYNC_QUEUE_HPP */
@@ -0,0 +1,307 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   call_metrics.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "call_metrics.hpp"
+
+#include <array>
+#include <cmath>
+#include <memory>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif // _MSC_VER
+
+namespace wilton {
+namespace fs {
+
+struct call_metrics::op_slot {
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> errors;
+    std::atomic<uint64_t> bytes_read;
+    std::atomic<uint64_t> bytes_written;
+    std::atomic<uint64_t> total_nanos;
+    std::array<std::atomic<uint64_t>, latency_buckets_count> latency;
+
+    op_slot() :
+    calls(0),
+    errors(0),
+    bytes_read(0),
+    bytes_written(0),
+    total_nanos(0) {
+        for (auto& bu : latency) {
+            bu.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+struct call_metrics::thread_block {
+    // allocated by the owning thread on first call of the operation
+    std::array<std::atomic<op_slot*>, max_ops> slots;
+    std::atomic<bool> owned;
+
+    thread_block() :
+    owned(true) {
+        for (auto& sl : slots) {
+            sl.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+};
+
+namespace { // anonymous
+
+const uint32_t max_bucket_bit = 44;
+
+struct thread_state {
+    call_metrics::thread_block* block = nullptr;
+    // innermost measured call
+    call_metrics::op_slot* current = nullptr;
+
+    ~thread_state() {
+        if (nullptr != block) {
+            block->owned.store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local thread_state tl_state;
+
+inline uint32_t highest_bit_index(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long idx = 0;
+    auto high = static_cast<uint32_t>(value >> 32);
+    if (0 != high) {
+        _BitScanReverse(std::addressof(idx), high);
+        return static_cast<uint32_t>(idx) + 32;
+    }
+    _BitScanReverse(std::addressof(idx), static_cast<uint32_t>(value));
+    return static_cast<uint32_t>(idx);
+#else // !_MSC_VER
+    return static_cast<uint32_t>(63 - __builtin_clzll(value));
+#endif // _MSC_VER
+}
+
+size_t bucket_index(uint64_t nanos) {
+    if (nanos < 8) {
+        return static_cast<size_t>(nanos);
+    }
+    auto bit = highest_bit_index(nanos);
+    if (bit > max_bucket_bit) {
+        return latency_buckets_count - 1;
+    }
+    // power of two and 3 next bits
+    return (bit - 2) * 8 + static_cast<size_t>((nanos >> (bit - 3)) & 7);
+}
+
+uint64_t bucket_highest_value(size_t idx) {
+    if (idx < 8) {
+        return idx;
+    }
+    auto shift = static_cast<uint32_t>(idx / 8 - 1);
+    auto lowest = static_cast<uint64_t>(8 + idx % 8) << shift;
+    return lowest + (static_cast<uint64_t>(1) << shift) - 1;
+}
+
+// only the owning thread writes, so increments do not need to be atomic
+inline void bump(std::atomic<uint64_t>& counter, uint64_t delta) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+int64_t current_time_millis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+uint64_t latency_quantile(const std::vector<uint64_t>& buckets, double quantile) {
+    uint64_t total = 0;
+    for (auto co : buckets) {
+        total += co;
+    }
+    if (0 == total) {
+        return 0;
+    }
+    auto rank = static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(total)));
+    rank = rank < 1 ? 1 : (rank > total ? total : rank);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return bucket_highest_value(i);
+        }
+    }
+    return bucket_highest_value(buckets.size() - 1);
+}
+
+call_metrics::call_scope::call_scope(call_metrics& metrics, size_t op_id) :
+slot(op_id < max_ops ? metrics.thread_slot(op_id) : nullptr),
+outer(tl_state.current),
+start(std::chrono::steady_clock::now()),
+success(false) {
+    tl_state.current = slot;
+}
+
+call_metrics::call_scope::~call_scope() {
+    tl_state.current = outer;
+    if (nullptr == slot) {
+        return;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto nanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    bump(slot->calls, 1);
+    if (!success) {
+        bump(slot->errors, 1);
+    }
+    bump(slot->total_nanos, nanos);
+    bump(slot->latency[bucket_index(nanos)], 1);
+}
+
+call_metrics::call_metrics() :
+reset_millis(current_time_millis()) { }
+
+size_t call_metrics::register_op(const std::string& name) {
+    std::lock_guard<std::mutex> guard{mutex};
+    for (size_t i = 0; i < names.size(); i++) {
+        if (name == names[i]) {
+            return i;
+        }
+    }
+    if (names.size() >= max_ops) {
+        return max_ops;
+    }
+    names.push_back(name);
+    return names.size() - 1;
+}
+
+size_t call_metrics::find_op(const std::string& name) {
+    std::lock_guard<std::mutex> guard{mutex};
+    for (size_t i = 0; i < names.size(); i++) {
+        if (name == names[i]) {
+            return i;
+        }
+    }
+    return max_ops;
+}
+
+metrics_snapshot call_metrics::snapshot(bool reset) {
+    std::lock_guard<std::mutex> guard{mutex};
+    auto res = metrics_snapshot();
+    res.since_millis = reset_millis;
+    auto current = collect();
+    for (size_t i = 0; i < current.size(); i++) {
+        auto om = current[i];
+        // counters only grow, ops registered after reset have no baseline
+        if (i < baseline.size()) {
+            auto& ba = baseline[i];
+            om.calls -= ba.calls;
+            om.errors -= ba.errors;
+            om.bytes_read -= ba.bytes_read;
+            om.bytes_written -= ba.bytes_written;
+            om.total_nanos -= ba.total_nanos;
+            for (size_t j = 0; j < latency_buckets_count; j++) {
+                om.latency_buckets[j] -= ba.latency_buckets[j];
+            }
+        }
+        if (om.calls > 0) {
+            res.ops.emplace_back(std::move(om));
+        }
+    }
+    if (reset) {
+        baseline = std::move(current);
+        reset_millis = current_time_millis();
+    }
+    return res;
+}
+
+void call_metrics::record_read(uint64_t bytes) {
+    auto slot = tl_state.current;
+    if (nullptr != slot) {
+        bump(slot->bytes_read, bytes);
+    }
+}
+
+void call_metrics::record_written(uint64_t bytes) {
+    auto slot = tl_state.current;
+    if (nullptr != slot) {
+        bump(slot->bytes_written, bytes);
+    }
+}
+
+call_metrics::op_slot* call_metrics::thread_slot(size_t op_id) {
+    auto& st = tl_state;
+    if (nullptr == st.block) {
+        std::lock_guard<std::mutex> guard{mutex};
+        for (auto bl : blocks) {
+            auto expected = false;
+            // counters written by the exited owner are continued
+            if (bl->owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                st.block = bl;
+                break;
+            }
+        }
+        if (nullptr == st.block) {
+            blocks.push_back(new thread_block());
+            st.block = blocks.back();
+        }
+    }
+    auto& entry = st.block->slots[op_id];
+    auto slot = entry.load(std::memory_order_relaxed);
+    if (nullptr == slot) {
+        slot = new op_slot();
+        entry.store(slot, std::memory_order_release);
+    }
+    return slot;
+}
+
+std::vector<op_metrics> call_metrics::collect() {
+    auto res = std::vector<op_metrics>();
+    res.resize(names.size());
+    for (size_t i = 0; i < names.size(); i++) {
+        auto& om = res[i];
+        om.name = names[i];
+        om.calls = 0;
+        om.errors = 0;
+        om.bytes_read = 0;
+        om.bytes_written = 0;
+        om.total_nanos = 0;
+        om.latency_buckets.resize(latency_buckets_count);
+        for (auto bl : blocks) {
+            auto slot = bl->slots[i].load(std::memory_order_acquire);
+            if (nullptr == slot) {
+                continue;
+            }
+            om.calls += slot->calls.load(std::memory_order_relaxed);
+            om.errors += slot->errors.load(std::memory_order_relaxed);
+            om.bytes_read += slot->bytes_read.load(std::memory_order_relaxed);
+            om.bytes_written += slot->bytes_written.load(std::memory_order_relaxed);
+            om.total_nanos += slot->total_nanos.load(std::memory_order_relaxed);
+            for (size_t j = 0; j < latency_buckets_count; j++) {
+                om.latency_buckets[j] += slot->latency[j].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    return res;
+}
+
+} // namespace
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   call_metrics.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_CALL_METRICS_HPP
+#define WILTON_FS_CALL_METRICS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+
+namespace wilton {
+namespace fs {
+
+// 8 sub-buckets per power of two (12.5% precision), values up to 2^45 ns (~9.8 hours)
+const size_t latency_buckets_count = 344;
+
+struct op_metrics {
+    std::string name;
+    uint64_t calls;
+    uint64_t errors;
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+    uint64_t total_nanos;
+    std::vector<uint64_t> latency_buckets;
+};
+
+struct metrics_snapshot {
+    // start of the measured period, milliseconds since epoch
+    int64_t since_millis;
+    std::vector<op_metrics> ops;
+};
+
+/**
+ * Latency value reported for a histogram quantile, the highest
+ * value that falls into the same bucket
+ *
+ * @param buckets latency histogram
+ * @param quantile quantile in [0, 1]
+ * @return latency in nanoseconds, 0 for empty histogram
+ */
+uint64_t latency_quantile(const std::vector<uint64_t>& buckets, double quantile);
+
+/**
+ * Per-call counters and latency histograms; each thread updates only
+ * its own counters (plain relaxed stores, no locked instructions),
+ * counters of all threads are merged on read; blocks of exited threads
+ * are reused by new threads, reset is implemented by subtracting
+ * a saved snapshot, so writers are never synchronized with readers;
+ * single instance per process is expected
+ */
+class call_metrics {
+public:
+    static const size_t max_ops = 96;
+
+    // defined in implementation
+    struct op_slot;
+    struct thread_block;
+
+    /**
+     * Measures a single call on the current thread, nested scopes
+     * (batch items) are allowed; call is counted as failed unless
+     * `succeeded` is called
+     */
+    class call_scope {
+        op_slot* slot;
+        op_slot* outer;
+        std::chrono::steady_clock::time_point start;
+        bool success;
+
+    public:
+        call_scope(call_metrics& metrics, size_t op_id);
+
+        call_scope(const call_scope&) = delete;
+
+        call_scope& operator=(const call_scope&) = delete;
+
+        ~call_scope();
+
+        void succeeded() {
+            success = true;
+        }
+    };
+
+private:
+    std::mutex mutex;
+    std::vector<std::string> names;
+    // never freed, threads may exit after the instance is destroyed
+    std::vector<thread_block*> blocks;
+    std::vector<op_metrics> baseline;
+    int64_t reset_millis;
+
+public:
+    call_metrics();
+
+    call_metrics(const call_metrics&) = delete;
+
+    call_metrics& operator=(const call_metrics&) = delete;
+
+    /**
+     * Registers an operation, expected to be called on module
+     * initialization before any calls are measured
+     *
+     * @param name operation name
+     * @return operation id
+     */
+    size_t register_op(const std::string& name);
+
+    /**
+     * @param name operation name
+     * @return operation id, `max_ops` if not registered
+     */
+    size_t find_op(const std::string& name);
+
+    /**
+     * Counters accumulated since the last reset (or creation),
+     * only operations that were called are included
+     *
+     * @param reset whether to start a new period, calls completed
+     *        after the snapshot is taken belong to the new period
+     * @return per-operation metrics
+     */
+    metrics_snapshot snapshot(bool reset);
+
+    /**
+     * Attributes bytes to the innermost call measured on the current
+     * thread, ignored outside of measured calls
+     */
+    static void record_read(uint64_t bytes);
+
+    static void record_written(uint64_t bytes);
+
+private:
+    op_slot* thread_slot(size_t op_id);
+
+    // mutex must be held
+    std::vector<op_metrics> collect();
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_CALL_METRICS_HPP */
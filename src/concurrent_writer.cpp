@@ -0,0 +1,441 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   concurrent_writer.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "concurrent_writer.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#ifdef STATICLIB_WINDOWS
+#include <io.h>
+#include <fcntl.h>
+#include <share.h>
+#include <sys/stat.h>
+#else // !STATICLIB_WINDOWS
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif // STATICLIB_WINDOWS
+
+#ifdef STATICLIB_LINUX
+#include <linux/falloc.h>
+#endif // STATICLIB_LINUX
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "wilton/support/exception.hpp"
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+std::string errno_str() {
+    return std::string(::strerror(errno));
+}
+
+int open_fd(const std::string& path, bool append) {
+#ifdef STATICLIB_WINDOWS
+    auto wpath = sl::utils::widen(path);
+    auto flags = _O_WRONLY | _O_CREAT | _O_BINARY | (append ? _O_APPEND : _O_TRUNC);
+    int fd = -1;
+    auto err = ::_wsopen_s(std::addressof(fd), wpath.c_str(), flags, _SH_DENYNO, _S_IREAD | _S_IWRITE);
+    if (0 != err) throw support::exception(TRACEMSG(
+            "Error opening file, path: [" + path + "]," +
+            " error: [" + ::strerror(err) + "]"));
+#else // !STATICLIB_WINDOWS
+    auto flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC);
+    int fd = -1;
+    do {
+        fd = ::open(path.c_str(), flags, 0644);
+    } while (-1 == fd && EINTR == errno);
+    if (-1 == fd) throw support::exception(TRACEMSG(
+            "Error opening file, path: [" + path + "]," +
+            " error: [" + errno_str() + "]"));
+#endif // STATICLIB_WINDOWS
+    return fd;
+}
+
+void close_fd(int fd) {
+#ifdef STATICLIB_WINDOWS
+    ::_close(fd);
+#else // !STATICLIB_WINDOWS
+    ::close(fd);
+#endif // STATICLIB_WINDOWS
+}
+
+void preallocate_fd(int fd, const std::string& path, uint64_t length) {
+#ifdef STATICLIB_LINUX
+    auto offset = ::lseek(fd, 0, SEEK_END);
+    if (static_cast<off_t>(-1) == offset) {
+        offset = 0;
+    }
+    // keep size, so appends are not placed after reserved space
+    if (0 != ::fallocate(fd, FALLOC_FL_KEEP_SIZE, offset, static_cast<off_t>(length))) {
+        if (EOPNOTSUPP == errno || ENOSYS == errno) return;
+        throw support::exception(TRACEMSG(
+                "Error preallocating file, path: [" + path + "]," +
+                " length: [" + sl::support::to_string(length) + "]," +
+                " error: [" + errno_str() + "]"));
+    }
+#else // !STATICLIB_LINUX
+    // advisory only, not supported on this platform
+    (void) fd;
+    (void) path;
+    (void) length;
+#endif // STATICLIB_LINUX
+}
+
+// returns errno, 0 on success
+int sync_fd(int fd) {
+#ifdef STATICLIB_WINDOWS
+    return 0 == ::_commit(fd) ? 0 : errno;
+#else // !STATICLIB_WINDOWS
+    for (;;) {
+#ifdef STATICLIB_LINUX
+        auto res = ::fdatasync(fd);
+#else // !STATICLIB_LINUX
+        auto res = ::fsync(fd);
+#endif // STATICLIB_LINUX
+        if (0 == res) return 0;
+        if (EINTR != errno) return errno;
+    }
+#endif // STATICLIB_WINDOWS
+}
+
+} // namespace
+
+/**
+ * Single background thread running interval syncs and batched
+ * (group commit) syncs for all writers; the module-wide instance
+ * is never destroyed, so its thread cannot outlive it
+ */
+class sync_service {
+    struct interval_entry {
+        std::weak_ptr<concurrent_writer> writer;
+        std::chrono::milliseconds interval;
+        std::chrono::steady_clock::time_point next;
+    };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::shared_ptr<concurrent_writer>> group_queue;
+    std::vector<interval_entry> interval_writers;
+    // new interval writer may be due before the current deadline
+    bool intervals_added;
+    bool stopping;
+    std::thread worker;
+
+public:
+    sync_service() :
+    intervals_added(false),
+    stopping(false),
+    worker([this] {
+        run();
+    }) { }
+
+    sync_service(const sync_service&) = delete;
+
+    sync_service& operator=(const sync_service&) = delete;
+
+    ~sync_service() {
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            stopping = true;
+        }
+        cv.notify_all();
+        worker.join();
+    }
+
+    void enqueue_group(std::shared_ptr<concurrent_writer> writer) {
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            group_queue.emplace_back(std::move(writer));
+        }
+        cv.notify_all();
+    }
+
+    void add_interval(std::weak_ptr<concurrent_writer> writer, std::chrono::milliseconds interval) {
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            auto next = std::chrono::steady_clock::now() + interval;
+            interval_writers.push_back({std::move(writer), interval, next});
+            intervals_added = true;
+        }
+        cv.notify_all();
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock{mutex};
+        while (!stopping) {
+            // checked on every iteration, so a steady stream
+            // of group commits cannot postpone interval syncs
+            auto deadline = sync_intervals(lock);
+            if (!group_queue.empty()) {
+                sync_group(lock);
+                continue;
+            }
+            auto ready = [this] {
+                return stopping || intervals_added || !group_queue.empty();
+            };
+            if (std::chrono::steady_clock::time_point::max() == deadline) {
+                cv.wait(lock, ready);
+            } else {
+                cv.wait_until(lock, deadline, ready);
+            }
+        }
+    }
+
+    void sync_group(std::unique_lock<std::mutex>& lock) {
+        // everything written before this point is covered by one sync per file
+        auto batch = std::move(group_queue);
+        group_queue.clear();
+        lock.unlock();
+        std::sort(batch.begin(), batch.end());
+        batch.erase(std::unique(batch.begin(), batch.end()), batch.end());
+        for (auto& wr : batch) {
+            wr->sync();
+        }
+        batch.clear();
+        lock.lock();
+    }
+
+    // syncs writers that are due, returns the next deadline
+    std::chrono::steady_clock::time_point sync_intervals(std::unique_lock<std::mutex>& lock) {
+        intervals_added = false;
+        auto now = std::chrono::steady_clock::now();
+        auto due = std::vector<std::shared_ptr<concurrent_writer>>();
+        auto deadline = std::chrono::steady_clock::time_point::max();
+        for (auto it = interval_writers.begin(); it != interval_writers.end();) {
+            auto wr = it->writer.lock();
+            if (nullptr == wr.get()) {
+                it = interval_writers.erase(it);
+                continue;
+            }
+            if (it->next <= now) {
+                due.emplace_back(std::move(wr));
+                it->next = now + it->interval;
+            }
+            deadline = std::min(deadline, it->next);
+            ++it;
+        }
+        if (!due.empty()) {
+            lock.unlock();
+            for (auto& wr : due) {
+                wr->sync();
+            }
+            // release writers outside of the lock, last owner closes the file
+            due.clear();
+            lock.lock();
+        }
+        return deadline;
+    }
+};
+
+namespace { // anonymous
+
+// intentionally leaked: writers may be released on the syncer thread
+// after static destructors have run, the thread ends with the process
+std::shared_ptr<sync_service> shared_sync_service() {
+    static auto service = std::shared_ptr<sync_service>(new sync_service(), [](sync_service*) {
+        // never destroyed
+    });
+    return service;
+}
+
+} // namespace
+
+sync_mode parse_sync_mode(const std::string& name) {
+    if ("none" == name) {
+        return sync_mode::none;
+    } else if ("onClose" == name) {
+        return sync_mode::on_close;
+    } else if ("interval" == name) {
+        return sync_mode::interval;
+    } else if ("every" == name) {
+        return sync_mode::every;
+    } else if ("group" == name) {
+        return sync_mode::group;
+    }
+    throw support::exception(TRACEMSG("Invalid sync mode specified: [" + name + "]," +
+            " supported modes: [none, onClose, interval, every, group]"));
+}
+
+concurrent_writer::concurrent_writer(const std::string& path, bool append, bool hex,
+        const writer_options& options) :
+fd(open_fd(path, append)),
+file_path(path.data(), path.length()),
+opts(options),
+hex(hex),
+closed(false),
+buffered(0),
+written_seq(0),
+synced_seq(0) {
+    try {
+        buffer.resize(std::max(opts.buffer_size, static_cast<size_t>(1)));
+        if (opts.preallocate > 0) {
+            preallocate_fd(fd, file_path, opts.preallocate);
+        }
+        if (sync_mode::interval == opts.sync || sync_mode::group == opts.sync) {
+            this->syncer = shared_sync_service();
+        }
+    } catch (...) {
+        close_fd(fd);
+        throw;
+    }
+}
+
+concurrent_writer::~concurrent_writer() {
+    try {
+        close();
+    } catch (...) {
+        // ignore
+    }
+    close_fd(fd);
+}
+
+std::shared_ptr<concurrent_writer> concurrent_writer::open(const std::string& path, bool append, bool hex,
+        const writer_options& options) {
+    auto writer = std::make_shared<concurrent_writer>(path, append, hex, options);
+    if (sync_mode::interval == options.sync) {
+        writer->syncer->add_interval(writer,
+                std::chrono::milliseconds(std::max(options.sync_interval_millis, 1u)));
+    }
+    return writer;
+}
+
+size_t concurrent_writer::write(sl::io::span<const char> data) {
+    uint64_t seq = 0;
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        if (closed) throw support::exception(TRACEMSG(
+                "Writer is already closed, path: [" + file_path + "]"));
+        if (buffered + data.size() > buffer.size()) {
+            flush_buffer();
+        }
+        if (data.size() >= buffer.size()) {
+            write_fd(data.data(), data.size());
+        } else {
+            std::memcpy(buffer.data() + buffered, data.data(), data.size());
+            buffered += data.size();
+        }
+        if (sync_mode::every == opts.sync || sync_mode::group == opts.sync) {
+            flush_buffer();
+        }
+        seq = written_seq;
+    }
+    if (sync_mode::every == opts.sync) {
+        sync();
+        wait_synced(seq);
+    } else if (sync_mode::group == opts.sync) {
+        syncer->enqueue_group(shared_from_this());
+        wait_synced(seq);
+    }
+    return data.size();
+}
+
+void concurrent_writer::sync() {
+    uint64_t target = 0;
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        flush_buffer();
+        target = written_seq;
+    }
+    // other threads keep appending while data is synced
+    auto err = sync_fd(fd);
+    {
+        std::lock_guard<std::mutex> guard{sync_mutex};
+        if (0 != err) {
+            sync_error = ::strerror(err);
+        } else {
+            synced_seq = std::max(synced_seq, target);
+        }
+    }
+    sync_cv.notify_all();
+}
+
+void concurrent_writer::close() {
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        if (closed) {
+            return;
+        }
+        closed = true;
+        flush_buffer();
+    }
+    if (sync_mode::none != opts.sync) {
+        sync();
+        std::lock_guard<std::mutex> guard{sync_mutex};
+        if (!sync_error.empty()) throw support::exception(TRACEMSG(
+                "Error syncing file, path: [" + file_path + "]," +
+                " error: [" + sync_error + "]"));
+    }
+}
+
+void concurrent_writer::flush_buffer() {
+    if (buffered > 0) {
+        write_fd(buffer.data(), buffered);
+        buffered = 0;
+    }
+}
+
+void concurrent_writer::write_fd(const char* data, size_t len) {
+    size_t written = 0;
+    while (written < len) {
+        auto chunk = len - written;
+#ifdef STATICLIB_WINDOWS
+        auto limit = static_cast<size_t>(std::numeric_limits<int>::max());
+        auto res = ::_write(fd, data + written, static_cast<unsigned int>(std::min(chunk, limit)));
+#else // !STATICLIB_WINDOWS
+        auto res = ::write(fd, data + written, chunk);
+        if (-1 == res && EINTR == errno) {
+            continue;
+        }
+#endif // STATICLIB_WINDOWS
+        if (res < 0) throw support::exception(TRACEMSG(
+                "Error writing file, path: [" + file_path + "]," +
+                " error: [" + errno_str() + "]"));
+        written += static_cast<size_t>(res);
+    }
+    written_seq += 1;
+}
+
+void concurrent_writer::wait_synced(uint64_t seq) {
+    std::unique_lock<std::mutex> lock{sync_mutex};
+    sync_cv.wait(lock, [this, seq] {
+        return synced_seq >= seq || !sync_error.empty();
+    });
+    if (synced_seq < seq) throw support::exception(TRACEMSG(
+            "Error syncing file, path: [" + file_path + "]," +
+            " error: [" + sync_error + "]"));
+}
+
+} // namespace
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   concurrent_writer.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_CONCURRENT_WRITER_HPP
+#define WILTON_FS_CONCURRENT_WRITER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+namespace wilton {
+namespace fs {
+
+enum class sync_mode {
+    // no explicit syncs
+    none,
+    // single sync when the writer is closed
+    on_close,
+    // background sync every `sync_interval_millis`
+    interval,
+    // sync after each write in the calling thread
+    every,
+    // each write waits for a sync, concurrent syncs are batched on a background thread
+    group
+};
+
+/**
+ * Parses sync mode name: "none", "onClose", "interval", "every" or "group"
+ *
+ * @param name mode name
+ * @return sync mode
+ */
+sync_mode parse_sync_mode(const std::string& name);
+
+struct writer_options {
+    size_t buffer_size;
+    // bytes to reserve on disk, file size is not changed
+    uint64_t preallocate;
+    sync_mode sync;
+    uint32_t sync_interval_millis;
+
+    writer_options() :
+    buffer_size(65536),
+    preallocate(0),
+    sync(sync_mode::none),
+    sync_interval_millis(1000) { }
+};
+
+class sync_service;
+
+/**
+ * Buffered file writer that can be used from multiple threads,
+ * each write is appended atomically relative to other writes;
+ * must be owned by `std::shared_ptr`
+ */
+class concurrent_writer : public std::enable_shared_from_this<concurrent_writer> {
+    // guards buffer and writes to descriptor
+    std::mutex mutex;
+    int fd;
+    std::string file_path;
+    writer_options opts;
+    bool hex;
+    bool closed;
+    std::vector<char> buffer;
+    size_t buffered;
+    uint64_t written_seq;
+    // guards durability state
+    std::mutex sync_mutex;
+    std::condition_variable sync_cv;
+    uint64_t synced_seq;
+    std::string sync_error;
+    std::shared_ptr<sync_service> syncer;
+
+public:
+    concurrent_writer(const std::string& path, bool append, bool hex, const writer_options& options);
+
+    concurrent_writer(const concurrent_writer&) = delete;
+
+    concurrent_writer& operator=(const concurrent_writer&) = delete;
+
+    ~concurrent_writer();
+
+    /**
+     * Opens a writer and registers it for background syncs if needed
+     *
+     * @param path file path
+     * @param append whether to append to existing file instead of truncating it
+     * @param hex whether input data is hex-encoded
+     * @param options buffering and durability options
+     * @return writer
+     */
+    static std::shared_ptr<concurrent_writer> open(const std::string& path, bool append, bool hex,
+            const writer_options& options);
+
+    const std::string& path() const {
+        return file_path;
+    }
+
+    bool is_hex() const {
+        return hex;
+    }
+
+    /**
+     * Appends data, hex input must be decoded by the caller;
+     * with `every` and `group` sync modes returns after data
+     * is durable
+     *
+     * @param data bytes to write
+     * @return number of bytes written
+     */
+    size_t write(sl::io::span<const char> data);
+
+    /**
+     * Writes out buffered data and syncs file data to disk,
+     * is called from background syncer
+     */
+    void sync();
+
+    /**
+     * Flushes buffered data and syncs unless sync mode is `none`,
+     * writes after close are rejected; descriptor is closed on destruction
+     */
+    void close();
+
+private:
+    void flush_buffer();
+
+    void write_fd(const char* data, size_t len);
+
+    void wait_synced(uint64_t seq);
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_CONCURRENT_WRITER_HPP */
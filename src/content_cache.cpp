@@ -0,0 +1,291 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   content_cache.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "content_cache.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <functional>
+
+#ifdef STATICLIB_LINUX
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif // STATICLIB_LINUX
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+std::string make_key(const std::string& path, bool hex) {
+    return (hex ? "h:" : "t:") + path;
+}
+
+bool same_identity(const file_stat& a, const file_stat& b) {
+    return a.type == b.type && a.inode == b.inode && a.size == b.size &&
+            a.mtime == b.mtime && a.ctime == b.ctime;
+}
+
+#ifdef STATICLIB_LINUX
+const uint32_t watch_mask = IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE |
+        IN_MOVE_SELF | IN_DELETE_SELF | IN_ONESHOT;
+#endif // STATICLIB_LINUX
+
+} // namespace
+
+content_cache::content_cache(size_t max_bytes) :
+shard_capacity(max_bytes / 16),
+hits(0),
+misses(0),
+invalidations(0),
+evictions(0),
+inotify_fd(-1) {
+    wakeup_fds[0] = -1;
+    wakeup_fds[1] = -1;
+#ifdef STATICLIB_LINUX
+    // without inotify entries are validated with stat on each hit
+    this->inotify_fd = ::inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (-1 != inotify_fd && 0 == ::pipe2(wakeup_fds, O_CLOEXEC)) {
+        this->watcher = std::thread([this] {
+            watch_loop();
+        });
+    } else if (-1 != inotify_fd) {
+        ::close(inotify_fd);
+        this->inotify_fd = -1;
+    }
+#endif // STATICLIB_LINUX
+}
+
+content_cache::~content_cache() {
+#ifdef STATICLIB_LINUX
+    if (watcher.joinable()) {
+        char byte = 1;
+        while (-1 == ::write(wakeup_fds[1], std::addressof(byte), 1) && EINTR == errno);
+        watcher.join();
+        ::close(wakeup_fds[0]);
+        ::close(wakeup_fds[1]);
+    }
+    if (-1 != inotify_fd) {
+        ::close(inotify_fd);
+    }
+#endif // STATICLIB_LINUX
+}
+
+std::shared_ptr<const std::string> content_cache::get(const std::string& path, bool hex) {
+    auto key = make_key(path, hex);
+    auto& sh = shard_for(key);
+    auto identity = file_stat();
+    {
+        std::lock_guard<std::mutex> guard{sh.mutex};
+        auto it = sh.index.find(key);
+        if (sh.index.end() == it) {
+            misses.fetch_add(1);
+            return std::shared_ptr<const std::string>();
+        }
+        auto en = it->second;
+        if (-1 != en->wd) {
+            // watched entries are removed on change
+            sh.lru.splice(sh.lru.begin(), sh.lru, en);
+            hits.fetch_add(1);
+            return en->content;
+        }
+        identity = en->identity;
+    }
+    auto current = file_stat();
+    auto valid = stat_path(path, true, current) && same_identity(identity, current);
+    std::lock_guard<std::mutex> guard{sh.mutex};
+    auto it = sh.index.find(key);
+    if (sh.index.end() == it) {
+        misses.fetch_add(1);
+        return std::shared_ptr<const std::string>();
+    }
+    auto en = it->second;
+    if (!valid || !same_identity(en->identity, current)) {
+        erase_entry(sh, en);
+        invalidations.fetch_add(1);
+        misses.fetch_add(1);
+        return std::shared_ptr<const std::string>();
+    }
+    sh.lru.splice(sh.lru.begin(), sh.lru, en);
+    hits.fetch_add(1);
+    return en->content;
+}
+
+void content_cache::put(const std::string& path, bool hex, const file_stat& identity,
+        std::shared_ptr<const std::string> content) {
+    if (content->length() > shard_capacity) {
+        return;
+    }
+    auto key = make_key(path, hex);
+    auto wd = add_watch(path, key);
+    auto& sh = shard_for(key);
+    auto stored = content.get();
+    {
+        std::lock_guard<std::mutex> guard{sh.mutex};
+        auto existing = sh.index.find(key);
+        if (sh.index.end() != existing) {
+            erase_entry(sh, existing->second);
+        }
+        auto size = content->length();
+        sh.lru.push_front({key, std::move(content), identity, wd});
+        sh.index.emplace(key, sh.lru.begin());
+        sh.bytes += size;
+        while (sh.bytes > shard_capacity && !sh.lru.empty()) {
+            erase_entry(sh, std::prev(sh.lru.end()));
+            evictions.fetch_add(1);
+        }
+    }
+    if (-1 == wd) {
+        return;
+    }
+    // file may have changed before the watch was added, the entry is already
+    // inserted, so changes after this stat are dropped by the watch loop
+    auto current = file_stat();
+    if (!stat_path(path, true, current) || !same_identity(identity, current)) {
+        std::lock_guard<std::mutex> guard{sh.mutex};
+        auto it = sh.index.find(key);
+        if (sh.index.end() != it && stored == it->second->content.get()) {
+            erase_entry(sh, it->second);
+        }
+    }
+}
+
+content_cache_stats content_cache::stats() {
+    uint64_t entries = 0;
+    uint64_t bytes = 0;
+    for (auto& sh : shards) {
+        std::lock_guard<std::mutex> guard{sh.mutex};
+        entries += sh.lru.size();
+        bytes += sh.bytes;
+    }
+    return {hits.load(), misses.load(), invalidations.load(), evictions.load(), entries, bytes};
+}
+
+content_cache::shard& content_cache::shard_for(const std::string& key) {
+    return shards[std::hash<std::string>()(key) % shards.size()];
+}
+
+int content_cache::add_watch(const std::string& path, const std::string& key) {
+#ifdef STATICLIB_LINUX
+    if (-1 == inotify_fd) {
+        return -1;
+    }
+    // fails when watches limit is reached, entry is validated with stat then
+    auto wd = ::inotify_add_watch(inotify_fd, path.c_str(), watch_mask);
+    if (-1 == wd) {
+        return -1;
+    }
+    std::lock_guard<std::mutex> guard{watch_mutex};
+    watches[wd].push_back(key);
+    return wd;
+#else // !STATICLIB_LINUX
+    (void) path;
+    (void) key;
+    return -1;
+#endif // STATICLIB_LINUX
+}
+
+void content_cache::drop_watch_key(int wd, const std::string& key) {
+    if (-1 == wd) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard{watch_mutex};
+    auto it = watches.find(wd);
+    if (watches.end() == it) {
+        return;
+    }
+    // same file watched for concurrent puts of the same key
+    // returns the same descriptor, each entry owns one key
+    auto& keys = it->second;
+    auto pos = std::find(keys.begin(), keys.end(), key);
+    if (keys.end() != pos) {
+        keys.erase(pos);
+    }
+    if (keys.empty()) {
+        watches.erase(it);
+#ifdef STATICLIB_LINUX
+        ::inotify_rm_watch(inotify_fd, wd);
+#endif // STATICLIB_LINUX
+    }
+}
+
+void content_cache::erase_entry(shard& sh, std::list<entry>::iterator it) {
+    drop_watch_key(it->wd, it->key);
+    sh.bytes -= it->content->length();
+    sh.index.erase(it->key);
+    sh.lru.erase(it);
+}
+
+void content_cache::watch_loop() {
+#ifdef STATICLIB_LINUX
+    alignas(struct inotify_event) char buf[8192];
+    for (;;) {
+        struct pollfd fds[2];
+        fds[0].fd = inotify_fd;
+        fds[0].events = POLLIN;
+        fds[1].fd = wakeup_fds[0];
+        fds[1].events = POLLIN;
+        if (-1 == ::poll(fds, 2, -1)) {
+            if (EINTR == errno) continue;
+            return;
+        }
+        if (0 != fds[1].revents) {
+            return;
+        }
+        for (;;) {
+            auto len = ::read(inotify_fd, buf, sizeof(buf));
+            if (len <= 0) {
+                break;
+            }
+            for (char* ptr = buf; ptr < buf + len;) {
+                auto ev = reinterpret_cast<struct inotify_event*>(ptr);
+                ptr += sizeof(struct inotify_event) + ev->len;
+                // oneshot watches are already removed by kernel
+                auto keys = std::vector<std::string>();
+                {
+                    std::lock_guard<std::mutex> guard{watch_mutex};
+                    auto it = watches.find(ev->wd);
+                    if (watches.end() == it) continue;
+                    keys = std::move(it->second);
+                    watches.erase(it);
+                }
+                for (auto& key : keys) {
+                    auto& sh = shard_for(key);
+                    std::lock_guard<std::mutex> guard{sh.mutex};
+                    auto it = sh.index.find(key);
+                    if (sh.index.end() != it && ev->wd == it->second->wd) {
+                        it->second->wd = -1;
+                        erase_entry(sh, it->second);
+                        invalidations.fetch_add(1);
+                    }
+                }
+            }
+        }
+    }
+#endif // STATICLIB_LINUX
+}
+
+} // namespace
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   content_cache.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_CONTENT_CACHE_HPP
+#define WILTON_FS_CONTENT_CACHE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "staticlib/config.hpp"
+
+#include "file_stat.hpp"
+
+namespace wilton {
+namespace fs {
+
+struct content_cache_stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t invalidations;
+    uint64_t evictions;
+    uint64_t entries;
+    uint64_t bytes;
+};
+
+/**
+ * Size-bounded LRU cache of read results (validated text or hex),
+ * entries are checked against file identity (inode, size, mtime,
+ * ctime) on each hit; on Linux files are also watched with inotify,
+ * watched entries are dropped on change and served without stat
+ * (renames of parent directories are not detected for them)
+ */
+class content_cache {
+    struct entry {
+        std::string key;
+        std::shared_ptr<const std::string> content;
+        file_stat identity;
+        // inotify watch descriptor, -1 if not watched
+        int wd;
+    };
+
+    struct shard {
+        std::mutex mutex;
+        std::list<entry> lru;
+        std::unordered_map<std::string, std::list<entry>::iterator> index;
+        size_t bytes = 0;
+    };
+
+    size_t shard_capacity;
+    std::array<shard, 16> shards;
+    std::atomic<uint64_t> hits;
+    std::atomic<uint64_t> misses;
+    std::atomic<uint64_t> invalidations;
+    std::atomic<uint64_t> evictions;
+    // watch descriptor -> keys
+    std::mutex watch_mutex;
+    std::unordered_map<int, std::vector<std::string>> watches;
+    int inotify_fd;
+    int wakeup_fds[2];
+    std::thread watcher;
+
+public:
+    explicit content_cache(size_t max_bytes);
+
+    content_cache(const content_cache&) = delete;
+
+    content_cache& operator=(const content_cache&) = delete;
+
+    ~content_cache();
+
+    /**
+     * Looks up a valid entry
+     *
+     * @param path file path
+     * @param hex whether hex-encoded contents are requested
+     * @return contents or null on miss
+     */
+    std::shared_ptr<const std::string> get(const std::string& path, bool hex);
+
+    /**
+     * Stores contents read after `identity` was obtained,
+     * entries larger than 1/16 of the cache size are not stored
+     *
+     * @param path file path
+     * @param hex whether contents are hex-encoded
+     * @param identity file stat taken before reading
+     * @param content contents to cache
+     */
+    void put(const std::string& path, bool hex, const file_stat& identity,
+            std::shared_ptr<const std::string> content);
+
+    content_cache_stats stats();
+
+private:
+    shard& shard_for(const std::string& key);
+
+    int add_watch(const std::string& path, const std::string& key);
+
+    void drop_watch_key(int wd, const std::string& key);
+
+    void erase_entry(shard& sh, std::list<entry>::iterator it);
+
+    void watch_loop();
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_CONTENT_CACHE_HPP */
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   cpu_features.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "cpu_features.hpp"
+
+#include <memory>
+
+#if defined(WILTON_FS_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(WILTON_FS_X86)
+#include <cpuid.h>
+#endif
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+#if defined(WILTON_FS_X86) && defined(_MSC_VER)
+
+struct msvc_features {
+    bool ssse3;
+    bool sse42;
+    bool avx2;
+    bool sha;
+
+    msvc_features() :
+    ssse3(false),
+    sse42(false),
+    avx2(false),
+    sha(false) {
+        int regs[4];
+        __cpuid(regs, 0);
+        auto max_leaf = regs[0];
+        __cpuid(regs, 1);
+        this->ssse3 = 0 != (regs[2] & (1 << 9));
+        this->sse42 = 0 != (regs[2] & (1 << 20));
+        auto sse41 = 0 != (regs[2] & (1 << 19));
+        auto osxsave = 0 != (regs[2] & (1 << 27));
+        auto avx = 0 != (regs[2] & (1 << 28));
+        // OS must preserve YMM state
+        auto ymm_enabled = osxsave && 0x6 == (_xgetbv(0) & 0x6);
+        if (max_leaf >= 7) {
+            __cpuidex(regs, 7, 0);
+            this->avx2 = avx && ymm_enabled && 0 != (regs[1] & (1 << 5));
+            this->sha = sse41 && 0 != (regs[1] & (1 << 29));
+        }
+    }
+};
+
+const msvc_features& features() {
+    static msvc_features feats;
+    return feats;
+}
+
+#endif // WILTON_FS_X86 && _MSC_VER
+
+#if defined(WILTON_FS_X86) && !defined(_MSC_VER)
+
+// not available in __builtin_cpu_supports on older compilers
+bool detect_sha() {
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (0 == __get_cpuid_count(7, 0, std::addressof(eax), std::addressof(ebx),
+            std::addressof(ecx), std::addressof(edx))) {
+        return false;
+    }
+    return 0 != (ebx & (1 << 29)) && 0 != __builtin_cpu_supports("sse4.1");
+}
+
+#endif // WILTON_FS_X86 && !_MSC_VER
+
+} // namespace
+
+bool cpu_has_ssse3() {
+#if defined(WILTON_FS_X86) && defined(_MSC_VER)
+    return features().ssse3;
+#elif defined(WILTON_FS_X86)
+    static bool res = 0 != __builtin_cpu_supports("ssse3");
+    return res;
+#else
+    return false;
+#endif
+}
+
+bool cpu_has_sse42() {
+#if defined(WILTON_FS_X86) && defined(_MSC_VER)
+    return features().sse42;
+#elif defined(WILTON_FS_X86)
+    static bool res = 0 != __builtin_cpu_supports("sse4.2");
+    return res;
+#else
+    return false;
+#endif
+}
+
+bool cpu_has_avx2() {
+#if defined(WILTON_FS_X86) && defined(_MSC_VER)
+    return features().avx2;
+#elif defined(WILTON_FS_X86)
+    static bool res = 0 != __builtin_cpu_supports("avx2");
+    return res;
+#else
+    return false;
+#endif
+}
+
+bool cpu_has_sha() {
+#if defined(WILTON_FS_X86) && defined(_MSC_VER)
+    return features().sha;
+#elif defined(WILTON_FS_X86)
+    static bool res = detect_sha();
+    return res;
+#else
+    return false;
+#endif
+}
+
+} // namespace
+}
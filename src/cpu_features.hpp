@@ -0,0 +1,60 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   cpu_features.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_CPU_FEATURES_HPP
+#define WILTON_FS_CPU_FEATURES_HPP
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define WILTON_FS_X86
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WILTON_FS_SSE2
+#endif
+#endif // x86
+
+// per-function ISA extensions, MSVC allows intrinsics without flags
+#if defined(WILTON_FS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define WILTON_FS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define WILTON_FS_TARGET(isa)
+#endif
+
+namespace wilton {
+namespace fs {
+
+/**
+ * Runtime CPU detection for kernels dispatch,
+ * always returns false on non-x86 platforms
+ */
+bool cpu_has_ssse3();
+
+bool cpu_has_sse42();
+
+bool cpu_has_avx2();
+
+// SHA extensions with SSE4.1 needed by their kernels
+bool cpu_has_sha();
+
+} // namespace
+}
+
+#endif /* WILTON_FS_CPU_FEATURES_HPP */
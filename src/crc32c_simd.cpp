@@ -0,0 +1,263 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   crc32c_simd.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "crc32c_simd.hpp"
+
+#include <cstring>
+#include <memory>
+
+#include "cpu_features.hpp"
+
+#ifdef WILTON_FS_X86
+#include <immintrin.h>
+#endif // WILTON_FS_X86
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+// reflected Castagnoli polynomial
+const uint32_t poly = 0x82f63b78;
+
+// lengths of interleaved blocks for hardware checksum
+const size_t long_block = 8192;
+const size_t short_block = 256;
+
+uint32_t gf2_matrix_times(const uint32_t* mat, uint32_t vec) {
+    uint32_t sum = 0;
+    while (0 != vec) {
+        if (0 != (vec & 1)) {
+            sum ^= *mat;
+        }
+        vec >>= 1;
+        mat += 1;
+    }
+    return sum;
+}
+
+void gf2_matrix_square(uint32_t* square, const uint32_t* mat) {
+    for (size_t n = 0; n < 32; n++) {
+        square[n] = gf2_matrix_times(mat, mat[n]);
+    }
+}
+
+void one_zero_bit_op(uint32_t* odd) {
+    odd[0] = poly;
+    uint32_t row = 1;
+    for (size_t n = 1; n < 32; n++) {
+        odd[n] = row;
+        row <<= 1;
+    }
+}
+
+// operator appending `len` zero bytes to the raw register, len must be a power of two
+void zeros_op(uint32_t* even, size_t len) {
+    uint32_t odd[32];
+    one_zero_bit_op(odd);
+    gf2_matrix_square(even, odd);
+    gf2_matrix_square(odd, even);
+    // next square puts operator for one zero byte in even
+    for (;;) {
+        gf2_matrix_square(even, odd);
+        len >>= 1;
+        if (0 == len) {
+            return;
+        }
+        gf2_matrix_square(odd, even);
+        len >>= 1;
+        if (0 == len) {
+            std::memcpy(even, odd, sizeof(odd));
+            return;
+        }
+    }
+}
+
+struct crc32c_tables {
+    uint32_t slices[8][256];
+    uint32_t long_zeros[4][256];
+    uint32_t short_zeros[4][256];
+
+    crc32c_tables() {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t crc = n;
+            for (size_t k = 0; k < 8; k++) {
+                crc = 0 != (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+            }
+            slices[0][n] = crc;
+        }
+        for (size_t n = 0; n < 256; n++) {
+            for (size_t k = 1; k < 8; k++) {
+                auto prev = slices[k - 1][n];
+                slices[k][n] = (prev >> 8) ^ slices[0][prev & 0xff];
+            }
+        }
+        fill_zeros(long_zeros, long_block);
+        fill_zeros(short_zeros, short_block);
+    }
+
+    static void fill_zeros(uint32_t zeros[][256], size_t len) {
+        uint32_t op[32];
+        zeros_op(op, len);
+        for (uint32_t n = 0; n < 256; n++) {
+            zeros[0][n] = gf2_matrix_times(op, n);
+            zeros[1][n] = gf2_matrix_times(op, n << 8);
+            zeros[2][n] = gf2_matrix_times(op, n << 16);
+            zeros[3][n] = gf2_matrix_times(op, n << 24);
+        }
+    }
+};
+
+const crc32c_tables& tables() {
+    static crc32c_tables tabs;
+    return tabs;
+}
+
+uint32_t load_le32(const uint8_t* ptr) {
+    return static_cast<uint32_t>(ptr[0]) | (static_cast<uint32_t>(ptr[1]) << 8) |
+            (static_cast<uint32_t>(ptr[2]) << 16) | (static_cast<uint32_t>(ptr[3]) << 24);
+}
+
+uint32_t update_scalar(uint32_t crc, const uint8_t* data, size_t len) {
+    auto& t = tables().slices;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        crc ^= load_le32(data + i);
+        auto hi = load_le32(data + i + 4);
+        crc = t[7][crc & 0xff] ^ t[6][(crc >> 8) & 0xff] ^ t[5][(crc >> 16) & 0xff] ^ t[4][crc >> 24] ^
+                t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^ t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+    }
+    for (; i < len; i++) {
+        crc = (crc >> 8) ^ t[0][(crc ^ data[i]) & 0xff];
+    }
+    return crc;
+}
+
+#ifdef WILTON_FS_X86
+
+inline uint32_t shift_crc(const uint32_t zeros[][256], uint32_t crc) {
+    return zeros[0][crc & 0xff] ^ zeros[1][(crc >> 8) & 0xff] ^
+            zeros[2][(crc >> 16) & 0xff] ^ zeros[3][crc >> 24];
+}
+
+WILTON_FS_TARGET("sse4.2")
+inline uint32_t crc_word(uint32_t crc, const uint8_t* ptr) {
+#if defined(__x86_64__) || defined(_M_X64)
+    uint64_t word;
+    std::memcpy(std::addressof(word), ptr, sizeof(word));
+    return static_cast<uint32_t>(_mm_crc32_u64(crc, word));
+#else // 32-bit
+    uint32_t lo;
+    uint32_t hi;
+    std::memcpy(std::addressof(lo), ptr, sizeof(lo));
+    std::memcpy(std::addressof(hi), ptr + 4, sizeof(hi));
+    return _mm_crc32_u32(_mm_crc32_u32(crc, lo), hi);
+#endif // 64-bit
+}
+
+// three independent streams hide the latency of crc32 instruction,
+// partial checksums are merged with precomputed shift tables
+WILTON_FS_TARGET("sse4.2")
+uint32_t update_sse42_blocks(uint32_t crc, const uint8_t* data, size_t len,
+        size_t block, const uint32_t zeros[][256], size_t& done) {
+    auto crc0 = crc;
+    while (len - done >= block * 3) {
+        uint32_t crc1 = 0;
+        uint32_t crc2 = 0;
+        auto ptr = data + done;
+        for (size_t i = 0; i < block; i += 8) {
+            crc0 = crc_word(crc0, ptr + i);
+            crc1 = crc_word(crc1, ptr + block + i);
+            crc2 = crc_word(crc2, ptr + block * 2 + i);
+        }
+        crc0 = shift_crc(zeros, crc0) ^ crc1;
+        crc0 = shift_crc(zeros, crc0) ^ crc2;
+        done += block * 3;
+    }
+    return crc0;
+}
+
+WILTON_FS_TARGET("sse4.2")
+uint32_t update_sse42(uint32_t crc, const uint8_t* data, size_t len) {
+    auto& tabs = tables();
+    size_t done = 0;
+    crc = update_sse42_blocks(crc, data, len, long_block, tabs.long_zeros, done);
+    crc = update_sse42_blocks(crc, data, len, short_block, tabs.short_zeros, done);
+    for (; done + 8 <= len; done += 8) {
+        crc = crc_word(crc, data + done);
+    }
+    for (; done < len; done++) {
+        crc = _mm_crc32_u8(crc, data[done]);
+    }
+    return crc;
+}
+
+#endif // WILTON_FS_X86
+
+} // namespace
+
+uint32_t crc32c_update(uint32_t crc, const char* data, size_t len) {
+    auto udata = reinterpret_cast<const uint8_t*>(data);
+    // kernels work on the raw (non-inverted) register
+    auto raw = crc ^ 0xffffffff;
+#ifdef WILTON_FS_X86
+    if (cpu_has_sse42()) {
+        return update_sse42(raw, udata, len) ^ 0xffffffff;
+    }
+#endif // WILTON_FS_X86
+    return update_scalar(raw, udata, len) ^ 0xffffffff;
+}
+
+uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, uint64_t len2) {
+    if (0 == len2) {
+        return crc1;
+    }
+    uint32_t even[32];
+    uint32_t odd[32];
+    one_zero_bit_op(odd);
+    gf2_matrix_square(even, odd);
+    gf2_matrix_square(odd, even);
+    // apply len2 zero bytes to crc1, operators are squared for each bit of len2
+    for (;;) {
+        gf2_matrix_square(even, odd);
+        if (0 != (len2 & 1)) {
+            crc1 = gf2_matrix_times(even, crc1);
+        }
+        len2 >>= 1;
+        if (0 == len2) {
+            break;
+        }
+        gf2_matrix_square(odd, even);
+        if (0 != (len2 & 1)) {
+            crc1 = gf2_matrix_times(odd, crc1);
+        }
+        len2 >>= 1;
+        if (0 == len2) {
+            break;
+        }
+    }
+    return crc1 ^ crc2;
+}
+
+} // namespace
+}
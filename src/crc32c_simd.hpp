@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   crc32c_simd.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_CRC32C_SIMD_HPP
+#define WILTON_FS_CRC32C_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace wilton {
+namespace fs {
+
+/**
+ * CRC-32C (Castagnoli), SSE4.2 `crc32` instruction on x86
+ * with runtime dispatch, slicing-by-8 tables otherwise
+ *
+ * @param crc checksum of the preceding data, 0 initially
+ * @param data input bytes
+ * @param len input length
+ * @return checksum including the input
+ */
+uint32_t crc32c_update(uint32_t crc, const char* data, size_t len);
+
+/**
+ * Checksum of two concatenated blocks from their checksums,
+ * allows to checksum parts of a file in parallel
+ *
+ * @param crc1 checksum of the first block
+ * @param crc2 checksum of the second block
+ * @param len2 length of the second block
+ * @return checksum of both blocks
+ */
+uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, uint64_t len2);
+
+} // namespace
+}
+
+#endif /* WILTON_FS_CRC32C_SIMD_HPP */
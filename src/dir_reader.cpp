@@ -0,0 +1,170 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   dir_reader.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "dir_reader.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#ifndef STATICLIB_WINDOWS
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif // !STATICLIB_WINDOWS
+
+#include "staticlib/tinydir.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "file_stat.hpp"
+
+namespace wilton {
+namespace fs {
+
+const std::string& entry_type_name(entry_type type) {
+    static const std::string file = "file";
+    static const std::string directory = "directory";
+    static const std::string symlink = "symlink";
+    static const std::string other = "other";
+    switch (type) {
+    case entry_type::file: return file;
+    case entry_type::directory: return directory;
+    case entry_type::symlink: return symlink;
+    default: return other;
+    }
+}
+
+#ifdef STATICLIB_WINDOWS
+
+dir_reader::dir_reader(const std::string& path) :
+dir_path(path.data(), path.length()),
+idx(0) {
+    try {
+        for (auto& pa : sl::tinydir::list_directory(path)) {
+            auto type = pa.is_directory() ? entry_type::directory :
+                    pa.is_regular_file() ? entry_type::file : entry_type::other;
+            entries.push_back({pa.filename(), type});
+        }
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+dir_reader::~dir_reader() { }
+
+bool dir_reader::stat_entry(const std::string& name, file_stat& out) const {
+    return stat_path(dir_path + "/" + name, false, out);
+}
+
+bool dir_reader::next(dir_entry& out) {
+    if (idx >= entries.size()) {
+        return false;
+    }
+    out = std::move(entries[idx]);
+    idx += 1;
+    return true;
+}
+
+#else // !STATICLIB_WINDOWS
+
+dir_reader::dir_reader(const std::string& path) :
+dir_path(path.data(), path.length()),
+dir(nullptr) {
+    // readdir fetches entries from kernel in large getdents64 batches
+    this->dir = ::opendir(path.c_str());
+    if (nullptr == dir) throw support::exception(TRACEMSG(
+            "Error opening directory, path: [" + path + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+}
+
+dir_reader::dir_reader(int parent_fd, const std::string& name, const std::string& path) :
+dir_path(path.data(), path.length()),
+dir(nullptr) {
+    auto fd = ::openat(parent_fd, name.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (-1 == fd) throw support::exception(TRACEMSG(
+            "Error opening directory, path: [" + path + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    this->dir = ::fdopendir(fd);
+    if (nullptr == dir) {
+        auto err = errno;
+        ::close(fd);
+        throw support::exception(TRACEMSG(
+                "Error opening directory, path: [" + path + "]," +
+                " error: [" + ::strerror(err) + "]"));
+    }
+}
+
+dir_reader::~dir_reader() {
+    if (nullptr != dir) {
+        ::closedir(static_cast<DIR*>(dir));
+    }
+}
+
+bool dir_reader::next(dir_entry& out) {
+    for (;;) {
+        errno = 0;
+        auto ent = ::readdir(static_cast<DIR*>(dir));
+        if (nullptr == ent) {
+            if (0 != errno) throw support::exception(TRACEMSG(
+                    "Error reading directory, path: [" + dir_path + "]," +
+                    " error: [" + ::strerror(errno) + "]"));
+            return false;
+        }
+        auto name = ent->d_name;
+        if ('.' == name[0] && ('\0' == name[1] || ('.' == name[1] && '\0' == name[2]))) {
+            continue;
+        }
+        out.name.assign(name);
+        auto dtype = ent->d_type;
+        if (DT_UNKNOWN == dtype) {
+            // filesystem does not report types, fall back to lstat
+            struct stat st;
+            if (0 == ::fstatat(fd(), name, std::addressof(st), AT_SYMLINK_NOFOLLOW)) {
+                dtype = S_ISREG(st.st_mode) ? DT_REG : S_ISDIR(st.st_mode) ? DT_DIR :
+                        S_ISLNK(st.st_mode) ? DT_LNK : DT_UNKNOWN;
+            }
+        }
+        switch (dtype) {
+        case DT_REG: out.type = entry_type::file; break;
+        case DT_DIR: out.type = entry_type::directory; break;
+        case DT_LNK: out.type = entry_type::symlink; break;
+        default: out.type = entry_type::other;
+        }
+        return true;
+    }
+}
+
+bool dir_reader::stat_entry(const std::string& name, file_stat& out) const {
+    return stat_at(fd(), name, false, out);
+}
+
+int dir_reader::fd() const {
+    return ::dirfd(static_cast<DIR*>(dir));
+}
+
+#endif // STATICLIB_WINDOWS
+
+} // namespace
+}
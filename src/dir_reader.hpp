@@ -0,0 +1,120 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   dir_reader.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_DIR_READER_HPP
+#define WILTON_FS_DIR_READER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+
+namespace wilton {
+namespace fs {
+
+enum class entry_type {
+    file, directory, symlink, other
+};
+
+const std::string& entry_type_name(entry_type type);
+
+struct file_stat;
+
+struct dir_entry {
+    std::string name;
+    entry_type type;
+};
+
+/**
+ * Single pass over directory entries, "." and ".." are skipped;
+ * entry types come from the directory itself (`d_type`) when
+ * the filesystem provides them, symlinks are not followed
+ */
+class dir_reader {
+    std::string dir_path;
+#ifdef STATICLIB_WINDOWS
+    std::vector<dir_entry> entries;
+    size_t idx;
+#else // !STATICLIB_WINDOWS
+    void* dir;
+#endif // STATICLIB_WINDOWS
+
+public:
+    explicit dir_reader(const std::string& path);
+
+#ifndef STATICLIB_WINDOWS
+    /**
+     * Opens a subdirectory relative to an open directory,
+     * symlinks are not followed
+     *
+     * @param parent_fd parent directory descriptor or `AT_FDCWD`
+     * @param name entry name in parent directory
+     * @param path full path, used in error messages only
+     */
+    dir_reader(int parent_fd, const std::string& name, const std::string& path);
+#endif // !STATICLIB_WINDOWS
+
+    dir_reader(const dir_reader&) = delete;
+
+    dir_reader& operator=(const dir_reader&) = delete;
+
+    ~dir_reader();
+
+    const std::string& path() const {
+        return dir_path;
+    }
+
+    /**
+     * Reads next entry
+     *
+     * @param out entry to fill
+     * @return false when no more entries
+     */
+    bool next(dir_entry& out);
+
+    /**
+     * Stats an entry of this directory without following symlinks,
+     * relative to the open directory where supported
+     *
+     * @param name entry name
+     * @param out stat to fill
+     * @return false on error
+     */
+    bool stat_entry(const std::string& name, file_stat& out) const;
+
+#ifndef STATICLIB_WINDOWS
+    /**
+     * Descriptor of the open directory, valid until destruction,
+     * to be used with `*at()` calls
+     *
+     * @return directory descriptor
+     */
+    int fd() const;
+#endif // !STATICLIB_WINDOWS
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_DIR_READER_HPP */
@@ -0,0 +1,311 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   dir_tree.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "dir_tree.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#ifndef STATICLIB_WINDOWS
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif // !STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+#include "staticlib/tinydir.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "dir_reader.hpp"
+#include "file_stat.hpp"
+#include "task_pool.hpp"
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+struct remove_state {
+    task_pool& pool;
+    size_t workers;
+    const std::atomic<bool>& cancelled;
+    std::atomic<uint64_t> directories;
+    std::atomic<uint64_t> files;
+
+    remove_state(task_pool& pool, size_t workers, const std::atomic<bool>& cancelled) :
+    pool(pool),
+    workers(workers),
+    cancelled(cancelled),
+    directories(0),
+    files(0) { }
+
+    void check_cancelled(const std::string& path) {
+        if (cancelled.load(std::memory_order_relaxed)) throw support::exception(TRACEMSG(
+                "Directory removal cancelled, path: [" + path + "]"));
+    }
+};
+
+// trailing separators are ignored, parent is empty for relative names
+void split_path(const std::string& path, std::string& parent, std::string& name) {
+    auto end = path.find_last_not_of("/\\");
+    if (std::string::npos == end) {
+        parent = std::string();
+        name = path;
+        return;
+    }
+    auto pos = path.find_last_of("/\\", end);
+    if (std::string::npos == pos) {
+        parent = std::string();
+        name = path.substr(0, end + 1);
+    } else {
+        parent = path.substr(0, pos + 1);
+        name = path.substr(pos + 1, end - pos);
+    }
+}
+
+#ifdef STATICLIB_WINDOWS
+
+void remove_contents(remove_state& st, const std::string& path) {
+    auto subdirs = std::vector<std::string>();
+    {
+        dir_reader reader(path);
+        auto en = dir_entry();
+        while (reader.next(en)) {
+            st.check_cancelled(path);
+            auto child = path + "/" + en.name;
+            if (entry_type::directory == en.type) {
+                subdirs.emplace_back(std::move(child));
+            } else {
+                sl::tinydir::path(child).remove();
+                st.files.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    st.pool.parallel_for(subdirs.size(), st.workers, [&st, &subdirs](size_t idx) {
+        remove_contents(st, subdirs[idx]);
+        sl::tinydir::path(subdirs[idx]).remove();
+        st.directories.fetch_add(1, std::memory_order_relaxed);
+    });
+}
+
+#else // !STATICLIB_WINDOWS
+
+// entries of a single directory are unlinked sequentially, concurrent
+// unlinks in the same directory only contend on its lock in kernel
+void remove_contents(remove_state& st, dir_reader& reader) {
+    auto subdirs = std::vector<std::string>();
+    auto en = dir_entry();
+    while (reader.next(en)) {
+        st.check_cancelled(reader.path());
+        if (entry_type::directory == en.type) {
+            subdirs.push_back(en.name);
+        } else if (0 == ::unlinkat(reader.fd(), en.name.c_str(), 0)) {
+            st.files.fetch_add(1, std::memory_order_relaxed);
+        } else if (EISDIR == errno) {
+            // replaced with a directory after listing
+            subdirs.push_back(en.name);
+        } else if (ENOENT != errno) {
+            throw support::exception(TRACEMSG(
+                    "Error removing file, path: [" + reader.path() + "/" + en.name + "]," +
+                    " error: [" + ::strerror(errno) + "]"));
+        }
+    }
+    // directory descriptor is shared by all children, *at() calls are thread-safe
+    st.pool.parallel_for(subdirs.size(), st.workers, [&st, &reader, &subdirs](size_t idx) {
+        auto& name = subdirs[idx];
+        auto path = reader.path() + "/" + name;
+        {
+            dir_reader child(reader.fd(), name, path);
+            remove_contents(st, child);
+        }
+        if (0 != ::unlinkat(reader.fd(), name.c_str(), AT_REMOVEDIR) && ENOENT != errno) {
+            throw support::exception(TRACEMSG(
+                    "Error removing directory, path: [" + path + "]," +
+                    " error: [" + ::strerror(errno) + "]"));
+        }
+        st.directories.fetch_add(1, std::memory_order_relaxed);
+    });
+}
+
+#endif // STATICLIB_WINDOWS
+
+} // namespace
+
+remove_tree_result remove_directory_tree(const std::string& path, size_t threads) {
+    static const std::atomic<bool> never(false);
+    return remove_directory_tree(path, threads, never);
+}
+
+remove_tree_result remove_directory_tree(const std::string& path, size_t threads,
+        const std::atomic<bool>& cancelled) {
+    auto root_st = file_stat();
+    if (!stat_path(path, false, root_st) || entry_type::directory != root_st.type) {
+        throw support::exception(TRACEMSG(
+                "Path is not a directory, path: [" + path + "]"));
+    }
+    auto pool = shared_task_pool();
+    remove_state st(*pool, std::max(threads, static_cast<size_t>(1)), cancelled);
+#ifdef STATICLIB_WINDOWS
+    remove_contents(st, path);
+    sl::tinydir::path(path).remove();
+#else // !STATICLIB_WINDOWS
+    {
+        dir_reader reader(AT_FDCWD, path, path);
+        remove_contents(st, reader);
+    }
+    if (0 != ::rmdir(path.c_str())) throw support::exception(TRACEMSG(
+            "Error removing directory, path: [" + path + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+#endif // STATICLIB_WINDOWS
+    st.directories.fetch_add(1, std::memory_order_relaxed);
+    return {st.directories.load(), st.files.load()};
+}
+
+std::string move_to_trash(const std::string& path) {
+    auto st = file_stat();
+    if (!stat_path(path, false, st) || entry_type::directory != st.type) {
+        throw support::exception(TRACEMSG(
+                "Path is not a directory, path: [" + path + "]"));
+    }
+    // sibling is on the same filesystem, so rename is atomic
+    static std::atomic<uint64_t> counter(0);
+    try {
+        // trash must stay valid if the working directory changes before purging
+        auto abs = sl::tinydir::full_path(path);
+        auto parent = std::string();
+        auto name = std::string();
+        split_path(abs, parent, name);
+        auto stamp = std::chrono::system_clock::now().time_since_epoch().count();
+        auto trash = parent + "." + name + ".trash." + sl::support::to_string(stamp) + "." +
+                sl::support::to_string(counter.fetch_add(1));
+        sl::tinydir::path(abs).rename(trash);
+        return trash;
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+trash_purger::trash_purger(std::function<void(const std::string&, const std::string&)> on_error) :
+on_error(std::move(on_error)),
+stopped(false) { }
+
+trash_purger::~trash_purger() {
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        stopped.store(true);
+    }
+    cv.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void trash_purger::submit(const std::string& trash_path) {
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        if (stopped.load()) throw support::exception(TRACEMSG(
+                "Trash purger is stopped, path: [" + trash_path + "]"));
+        queue.push_back(trash_path);
+        if (!worker.joinable()) {
+            worker = std::thread([this] {
+                this->run();
+            });
+        }
+    }
+    cv.notify_one();
+}
+
+void trash_purger::run() {
+    for (;;) {
+        auto trash = std::string();
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            cv.wait(lock, [this] {
+                return stopped.load() || !queue.empty();
+            });
+            if (stopped.load()) {
+                return;
+            }
+            trash = std::move(queue.front());
+            queue.pop_front();
+        }
+        try {
+            // single worker, the shared pool is not used
+            remove_directory_tree(trash, 1, stopped);
+        } catch (const std::exception& e) {
+            if (!stopped.load()) {
+                on_error(trash, e.what());
+            }
+        }
+    }
+}
+
+uint32_t create_directories(const std::string& path) {
+    auto st = file_stat();
+    if (stat_path(path, true, st)) {
+        if (entry_type::directory != st.type) throw support::exception(TRACEMSG(
+                "Path exists and is not a directory, path: [" + path + "]"));
+        return 0;
+    }
+    auto parent = std::string();
+    auto name = std::string();
+    split_path(path, parent, name);
+    uint32_t created = 0;
+    // root and drive prefixes always exist
+    if (parent.length() > 1 && !(3 == parent.length() && ':' == parent[1])) {
+        created = create_directories(parent.substr(0, parent.length() - 1));
+    }
+#ifdef STATICLIB_WINDOWS
+    try {
+        sl::tinydir::create_directory(path);
+    } catch (const std::exception& e) {
+        // may be created concurrently
+        if (!stat_path(path, true, st) || entry_type::directory != st.type) {
+            throw support::exception(TRACEMSG(e.what()));
+        }
+        return created;
+    }
+#else // !STATICLIB_WINDOWS
+    if (0 != ::mkdir(path.c_str(), 0777)) {
+        auto err = errno;
+        // may be created concurrently
+        if (EEXIST != err || !stat_path(path, true, st) || entry_type::directory != st.type) {
+            throw support::exception(TRACEMSG(
+                    "Error creating directory, path: [" + path + "]," +
+                    " error: [" + ::strerror(err) + "]"));
+        }
+        return created;
+    }
+#endif // STATICLIB_WINDOWS
+    return created + 1;
+}
+
+} // namespace
+}
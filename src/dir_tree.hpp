@@ -0,0 +1,125 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   dir_tree.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_DIR_TREE_HPP
+#define WILTON_FS_DIR_TREE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "staticlib/config.hpp"
+
+namespace wilton {
+namespace fs {
+
+struct remove_tree_result {
+    uint64_t directories;
+    // all non-directory entries, symlinks are removed, not followed
+    uint64_t files;
+};
+
+/**
+ * Recursive removal, entries are unlinked relative to open directory
+ * descriptors (`unlinkat`), so renames of parent directories during
+ * removal cannot redirect it; subdirectories are processed in parallel
+ * on the shared task pool and removed after their contents
+ *
+ * @param path directory path, symlink to directory is not accepted
+ * @param threads max parallelism, including the calling thread
+ * @return removed entries counts
+ */
+remove_tree_result remove_directory_tree(const std::string& path, size_t threads);
+
+/**
+ * Same as above, the flag is checked between entries and removal
+ * throws once it is set, leaving the rest of the tree on disk
+ *
+ * @param path directory path, symlink to directory is not accepted
+ * @param threads max parallelism, including the calling thread
+ * @param cancelled cancellation flag
+ * @return removed entries counts
+ */
+remove_tree_result remove_directory_tree(const std::string& path, size_t threads,
+        const std::atomic<bool>& cancelled);
+
+/**
+ * Renames directory to a unique hidden sibling, so the original
+ * path becomes free immediately and the tree can be removed later
+ *
+ * @param path directory path
+ * @return new path, always absolute
+ */
+std::string move_to_trash(const std::string& path);
+
+/**
+ * Removes trashed trees one by one on its own thread, so the shared
+ * task pool is not occupied; destructor cancels the current removal
+ * and returns without purging the queued trees
+ */
+class trash_purger {
+    std::function<void(const std::string&, const std::string&)> on_error;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::string> queue;
+    std::atomic<bool> stopped;
+    // started on first submit
+    std::thread worker;
+
+public:
+    /**
+     * @param on_error called on the purge thread with trash path and error message
+     */
+    explicit trash_purger(std::function<void(const std::string&, const std::string&)> on_error);
+
+    trash_purger(const trash_purger&) = delete;
+
+    trash_purger& operator=(const trash_purger&) = delete;
+
+    ~trash_purger();
+
+    void submit(const std::string& trash_path);
+
+private:
+    void run();
+};
+
+/**
+ * Creates directory together with all missing parents,
+ * existing directories are accepted
+ *
+ * @param path directory path
+ * @return number of directories created
+ */
+uint32_t create_directories(const std::string& path);
+
+} // namespace
+}
+
+#endif /* WILTON_FS_DIR_TREE_HPP */
@@ -0,0 +1,267 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   dir_walker.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "dir_walker.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#ifndef STATICLIB_WINDOWS
+#include <sys/stat.h>
+#endif // !STATICLIB_WINDOWS
+
+#include "staticlib/tinydir.hpp"
+
+#include "file_stat.hpp"
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+const size_t max_errors = 1024;
+
+bool is_directory_target(const std::string& path) {
+#ifdef STATICLIB_WINDOWS
+    try {
+        return sl::tinydir::path(path).is_directory();
+    } catch (const std::exception&) {
+        return false;
+    }
+#else // !STATICLIB_WINDOWS
+    struct stat st;
+    return 0 == ::stat(path.c_str(), std::addressof(st)) && S_ISDIR(st.st_mode);
+#endif // STATICLIB_WINDOWS
+}
+
+} // namespace
+
+bool glob_match(const std::string& pattern, const std::string& name) {
+    size_t pi = 0;
+    size_t ni = 0;
+    size_t star_pi = std::string::npos;
+    size_t star_ni = 0;
+    while (ni < name.length()) {
+        if (pi < pattern.length() && ('?' == pattern[pi] || pattern[pi] == name[ni])) {
+            pi += 1;
+            ni += 1;
+        } else if (pi < pattern.length() && '*' == pattern[pi]) {
+            star_pi = pi;
+            star_ni = ni;
+            pi += 1;
+        } else if (std::string::npos != star_pi) {
+            // let the last star consume one more char
+            pi = star_pi + 1;
+            star_ni += 1;
+            ni = star_ni;
+        } else {
+            return false;
+        }
+    }
+    while (pi < pattern.length() && '*' == pattern[pi]) {
+        pi += 1;
+    }
+    return pi == pattern.length();
+}
+
+dir_walker::dir_walker(const std::string& root, const walk_options& options, size_t workers_count,
+        std::function<bool(size_t, walk_entry&&)> on_entry) :
+root(root.data(), root.length()),
+opts(options),
+on_entry(std::move(on_entry)),
+pending(1),
+stopped(false) {
+    for (size_t i = 0; i < std::max(workers_count, static_cast<size_t>(1)); i++) {
+        queues.emplace_back(new worker_queue());
+    }
+    queues.front()->tasks.push_back({std::string(), 0});
+}
+
+void dir_walker::work(size_t worker_idx) {
+    size_t idle_rounds = 0;
+    for (;;) {
+        auto task = dir_task();
+        if (pop_task(worker_idx, task)) {
+            idle_rounds = 0;
+            if (!stopped.load()) {
+                process(worker_idx, task);
+            }
+            pending.fetch_sub(1);
+            continue;
+        }
+        if (0 == pending.load()) {
+            return;
+        }
+        // other workers are still listing, new tasks may appear
+        idle_rounds += 1;
+        if (idle_rounds < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+}
+
+void dir_walker::stop() {
+    stopped.store(true);
+}
+
+std::vector<walk_error> dir_walker::collected_errors() {
+    std::lock_guard<std::mutex> guard{errors_mutex};
+    return errors;
+}
+
+bool dir_walker::pop_task(size_t worker_idx, dir_task& out) {
+    {
+        auto& own = *queues[worker_idx];
+        std::lock_guard<std::mutex> guard{own.mutex};
+        if (!own.tasks.empty()) {
+            out = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t i = 1; i < queues.size(); i++) {
+        auto& victim = *queues[(worker_idx + i) % queues.size()];
+        std::lock_guard<std::mutex> guard{victim.mutex};
+        if (!victim.tasks.empty()) {
+            // steal the oldest (usually the biggest) subtree
+            out = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool dir_walker::mark_visited(const std::string& path) {
+    auto st = file_stat();
+    // unreadable directory is reported on listing,
+    // inode numbers are not available on Windows
+    if (!stat_path(path, true, st) || 0 == st.inode) {
+        return true;
+    }
+    std::lock_guard<std::mutex> guard{visited_mutex};
+    return visited.insert(std::make_pair(st.dev, st.inode)).second;
+}
+
+void dir_walker::process(size_t worker_idx, const dir_task& task) {
+    auto full = task.rel.empty() ? root : root + "/" + task.rel;
+    // symlinks to ancestors would loop, other repeats are listed once
+    if (opts.follow_symlinks && !mark_visited(full)) {
+        return;
+    }
+    try {
+        dir_reader reader(full);
+        auto de = dir_entry();
+        auto depth = task.depth + 1;
+        while (!stopped.load() && reader.next(de)) {
+            auto rel = task.rel.empty() ? de.name : task.rel + "/" + de.name;
+            auto descend = entry_type::directory == de.type ||
+                    (entry_type::symlink == de.type && opts.follow_symlinks &&
+                            is_directory_target(full + "/" + de.name));
+            if (descend && depth < opts.max_depth) {
+                pending.fetch_add(1);
+                auto& own = *queues[worker_idx];
+                std::lock_guard<std::mutex> guard{own.mutex};
+                own.tasks.push_back({rel, depth});
+            }
+            if (opts.glob.empty() || glob_match(opts.glob, de.name)) {
+                if (!on_entry(worker_idx, {std::move(rel), de.type, depth})) {
+                    stop();
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> guard{errors_mutex};
+        if (errors.size() < max_errors) {
+            errors.push_back({full, e.what()});
+        }
+    }
+}
+
+dir_walk_stream::dir_walk_stream(const std::string& root, const walk_options& options,
+        size_t threads_count, size_t queue_capacity) :
+capacity(queue_capacity),
+running(0),
+closed(false),
+walker(root, options, threads_count, [this](size_t, walk_entry&& en) {
+    return this->enqueue(std::move(en));
+}) {
+    this->running = walker.workers_count();
+    for (size_t i = 0; i < walker.workers_count(); i++) {
+        threads.emplace_back([this, i] {
+            walker.work(i);
+            {
+                std::lock_guard<std::mutex> guard{mutex};
+                running -= 1;
+            }
+            cv_not_empty.notify_all();
+        });
+    }
+}
+
+dir_walk_stream::~dir_walk_stream() {
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        closed = true;
+    }
+    walker.stop();
+    cv_not_full.notify_all();
+    for (auto& th : threads) {
+        th.join();
+    }
+}
+
+std::vector<walk_entry> dir_walk_stream::next(size_t max_count) {
+    auto res = std::vector<walk_entry>();
+    std::unique_lock<std::mutex> lock{mutex};
+    cv_not_empty.wait(lock, [this] {
+        return !queue.empty() || 0 == running;
+    });
+    while (!queue.empty() && res.size() < max_count) {
+        res.emplace_back(std::move(queue.front()));
+        queue.pop_front();
+    }
+    lock.unlock();
+    cv_not_full.notify_all();
+    return res;
+}
+
+bool dir_walk_stream::enqueue(walk_entry&& entry) {
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        cv_not_full.wait(lock, [this] {
+            return closed || queue.size() < capacity;
+        });
+        if (closed) {
+            return false;
+        }
+        queue.emplace_back(std::move(entry));
+    }
+    cv_not_empty.notify_one();
+    return true;
+}
+
+} // namespace
+}
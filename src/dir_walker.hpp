@@ -0,0 +1,190 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   dir_walker.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_DIR_WALKER_HPP
+#define WILTON_FS_DIR_WALKER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dir_reader.hpp"
+
+namespace wilton {
+namespace fs {
+
+struct walk_entry {
+    // relative to the walk root, '/'-separated
+    std::string path;
+    entry_type type;
+    // 1 for direct children of the root
+    uint32_t depth;
+};
+
+struct walk_error {
+    std::string path;
+    std::string message;
+};
+
+struct walk_options {
+    uint32_t max_depth;
+    // matched against entry names, directories are traversed regardless
+    std::string glob;
+    // each directory is listed once, even when reachable through several links
+    bool follow_symlinks;
+
+    walk_options() :
+    max_depth(std::numeric_limits<uint32_t>::max()),
+    follow_symlinks(false) { }
+};
+
+/**
+ * Glob matching with `*` and `?` wildcards
+ *
+ * @param pattern glob pattern
+ * @param name string to match
+ * @return true on match
+ */
+bool glob_match(const std::string& pattern, const std::string& name);
+
+/**
+ * Recursive traversal shared between a fixed number of workers,
+ * each worker owns a queue of directories and steals from other
+ * queues when its own one is empty; entries are reported in
+ * no particular order
+ */
+class dir_walker {
+    struct dir_task {
+        std::string rel;
+        uint32_t depth;
+    };
+
+    struct worker_queue {
+        std::mutex mutex;
+        std::deque<dir_task> tasks;
+    };
+
+    std::string root;
+    walk_options opts;
+    // called concurrently with worker index, returns false to stop the walk
+    std::function<bool(size_t, walk_entry&&)> on_entry;
+    std::vector<std::unique_ptr<worker_queue>> queues;
+    std::atomic<size_t> pending;
+    std::atomic<bool> stopped;
+    std::mutex errors_mutex;
+    std::vector<walk_error> errors;
+    // (dev, inode) of listed directories, tracked only when following symlinks
+    std::mutex visited_mutex;
+    std::set<std::pair<uint64_t, uint64_t>> visited;
+
+public:
+    dir_walker(const std::string& root, const walk_options& options, size_t workers_count,
+            std::function<bool(size_t, walk_entry&&)> on_entry);
+
+    dir_walker(const dir_walker&) = delete;
+
+    dir_walker& operator=(const dir_walker&) = delete;
+
+    size_t workers_count() const {
+        return queues.size();
+    }
+
+    /**
+     * Worker body, returns when the whole tree is traversed or the walk is stopped
+     *
+     * @param worker_idx index in [0, workers_count)
+     */
+    void work(size_t worker_idx);
+
+    void stop();
+
+    /**
+     * Directories that cannot be read are skipped and reported here
+     *
+     * @return errors collected so far
+     */
+    std::vector<walk_error> collected_errors();
+
+private:
+    bool pop_task(size_t worker_idx, dir_task& out);
+
+    bool mark_visited(const std::string& path);
+
+    void process(size_t worker_idx, const dir_task& task);
+};
+
+/**
+ * Walk running on its own threads, entries are passed
+ * to the consumer through a bounded queue
+ */
+class dir_walk_stream {
+    std::mutex mutex;
+    std::condition_variable cv_not_full;
+    std::condition_variable cv_not_empty;
+    std::deque<walk_entry> queue;
+    size_t capacity;
+    size_t running;
+    bool closed;
+    dir_walker walker;
+    std::vector<std::thread> threads;
+
+public:
+    dir_walk_stream(const std::string& root, const walk_options& options,
+            size_t threads_count, size_t queue_capacity);
+
+    dir_walk_stream(const dir_walk_stream&) = delete;
+
+    dir_walk_stream& operator=(const dir_walk_stream&) = delete;
+
+    ~dir_walk_stream();
+
+    /**
+     * Blocks until at least one entry is available
+     *
+     * @param max_count max number of entries to return
+     * @return entries, empty vector when the walk is finished
+     */
+    std::vector<walk_entry> next(size_t max_count);
+
+    std::vector<walk_error> collected_errors() {
+        return walker.collected_errors();
+    }
+
+private:
+    bool enqueue(walk_entry&& entry);
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_DIR_WALKER_HPP */
@@ -0,0 +1,493 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   fast_copy.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "fast_copy.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifndef STATICLIB_WINDOWS
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif // !STATICLIB_WINDOWS
+
+#ifdef STATICLIB_LINUX
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#ifndef FICLONE
+#define FICLONE _IOW(0x94, 9, int)
+#endif // FICLONE
+#endif // STATICLIB_LINUX
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+#include "staticlib/tinydir.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "dir_walker.hpp"
+#include "file_stat.hpp"
+#include "task_pool.hpp"
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+#ifndef STATICLIB_WINDOWS
+
+const size_t stream_buffer_size = 1 << 18;
+
+std::string errno_str() {
+    return std::string(::strerror(errno));
+}
+
+class fd_holder {
+    int fd;
+
+public:
+    explicit fd_holder(int fd) :
+    fd(fd) { }
+
+    fd_holder(const fd_holder&) = delete;
+
+    fd_holder& operator=(const fd_holder&) = delete;
+
+    ~fd_holder() {
+        if (-1 != fd) {
+            ::close(fd);
+        }
+    }
+
+    int get() const {
+        return fd;
+    }
+};
+
+int open_retry(const std::string& path, int flags, mode_t mode) {
+    int fd = -1;
+    do {
+        fd = ::open(path.c_str(), flags | O_CLOEXEC, mode);
+    } while (-1 == fd && EINTR == errno);
+    return fd;
+}
+
+struct copy_state {
+    int src;
+    int dst;
+    const std::string& from;
+    const std::string& to;
+    copy_method method;
+};
+
+bool is_unsupported_error(int err) {
+    return ENOSYS == err || EXDEV == err || EINVAL == err ||
+            EOPNOTSUPP == err || ENOTSUP == err || ENOTTY == err;
+}
+
+[[noreturn]] void throw_copy_error(const copy_state& cs, uint64_t offset) {
+    throw support::exception(TRACEMSG(
+            "Error copying file, from: [" + cs.from + "], to: [" + cs.to + "]," +
+            " offset: [" + sl::support::to_string(offset) + "]," +
+            " error: [" + errno_str() + "]"));
+}
+
+// all segment copiers advance offsets/length on progress and return false
+// if the method is not supported, so the next one can continue
+
+bool copy_segment_range(copy_state& cs, uint64_t& offset, uint64_t& dst_offset, uint64_t& length) {
+#if defined(STATICLIB_LINUX) && defined(__NR_copy_file_range)
+    while (length > 0) {
+        loff_t in_off = static_cast<loff_t>(offset);
+        loff_t out_off = static_cast<loff_t>(dst_offset);
+        auto chunk = static_cast<size_t>(std::min(length, static_cast<uint64_t>(1 << 30)));
+        // raw syscall, glibc wrapper is not available on older systems
+        auto res = ::syscall(__NR_copy_file_range, cs.src, std::addressof(in_off),
+                cs.dst, std::addressof(out_off), chunk, 0u);
+        if (-1 == res) {
+            if (EINTR == errno) continue;
+            if (is_unsupported_error(errno)) return false;
+            throw_copy_error(cs, offset);
+        }
+        if (0 == res) {
+            // source was truncated concurrently
+            length = 0;
+            break;
+        }
+        offset += static_cast<uint64_t>(res);
+        dst_offset += static_cast<uint64_t>(res);
+        length -= static_cast<uint64_t>(res);
+    }
+    return true;
+#else // !__NR_copy_file_range
+    (void) cs;
+    (void) offset;
+    (void) dst_offset;
+    (void) length;
+    return false;
+#endif // __NR_copy_file_range
+}
+
+bool copy_segment_sendfile(copy_state& cs, uint64_t& offset, uint64_t& dst_offset, uint64_t& length) {
+#ifdef STATICLIB_LINUX
+    if (static_cast<off_t>(-1) == ::lseek(cs.dst, static_cast<off_t>(dst_offset), SEEK_SET)) {
+        throw_copy_error(cs, offset);
+    }
+    while (length > 0) {
+        off_t in_off = static_cast<off_t>(offset);
+        auto chunk = static_cast<size_t>(std::min(length, static_cast<uint64_t>(1 << 30)));
+        auto res = ::sendfile(cs.dst, cs.src, std::addressof(in_off), chunk);
+        if (-1 == res) {
+            if (EINTR == errno) continue;
+            if (is_unsupported_error(errno)) return false;
+            throw_copy_error(cs, offset);
+        }
+        if (0 == res) {
+            length = 0;
+            break;
+        }
+        offset += static_cast<uint64_t>(res);
+        dst_offset += static_cast<uint64_t>(res);
+        length -= static_cast<uint64_t>(res);
+    }
+    return true;
+#else // !STATICLIB_LINUX
+    (void) cs;
+    (void) offset;
+    (void) dst_offset;
+    (void) length;
+    return false;
+#endif // STATICLIB_LINUX
+}
+
+void copy_segment_stream(copy_state& cs, uint64_t& offset, uint64_t& dst_offset, uint64_t& length) {
+    auto buf = std::unique_ptr<char[]>(new char[stream_buffer_size]);
+    while (length > 0) {
+        auto chunk = static_cast<size_t>(std::min(length, static_cast<uint64_t>(stream_buffer_size)));
+        auto read = ::pread(cs.src, buf.get(), chunk, static_cast<off_t>(offset));
+        if (-1 == read) {
+            if (EINTR == errno) continue;
+            throw_copy_error(cs, offset);
+        }
+        if (0 == read) {
+            length = 0;
+            break;
+        }
+        size_t written = 0;
+        while (written < static_cast<size_t>(read)) {
+            auto res = ::pwrite(cs.dst, buf.get() + written, static_cast<size_t>(read) - written,
+                    static_cast<off_t>(dst_offset + written));
+            if (-1 == res) {
+                if (EINTR == errno) continue;
+                throw_copy_error(cs, offset + written);
+            }
+            written += static_cast<size_t>(res);
+        }
+        offset += static_cast<uint64_t>(read);
+        dst_offset += static_cast<uint64_t>(read);
+        length -= static_cast<uint64_t>(read);
+    }
+}
+
+// returns number of bytes copied, less than length only on source EOF
+uint64_t copy_segment(copy_state& cs, uint64_t offset, uint64_t dst_offset, uint64_t length) {
+    auto start = offset;
+    if (copy_method::copy_range == cs.method) {
+        if (copy_segment_range(cs, offset, dst_offset, length)) return offset - start;
+        cs.method = copy_method::sendfile;
+    }
+    if (copy_method::sendfile == cs.method) {
+        if (copy_segment_sendfile(cs, offset, dst_offset, length)) return offset - start;
+        cs.method = copy_method::stream;
+    }
+    copy_segment_stream(cs, offset, dst_offset, length);
+    return offset - start;
+}
+
+// buffer is grown until the target fits, link size is not reliable on procfs
+bool read_symlink(const std::string& path, std::string& target) {
+    target.resize(256);
+    for (;;) {
+        auto len = ::readlink(path.c_str(), std::addressof(target.front()), target.length());
+        if (-1 == len) {
+            return false;
+        }
+        if (static_cast<size_t>(len) < target.length()) {
+            target.resize(static_cast<size_t>(len));
+            return true;
+        }
+        target.resize(target.length() * 2);
+    }
+}
+
+#endif // !STATICLIB_WINDOWS
+
+void create_dir(const std::string& path) {
+#ifdef STATICLIB_WINDOWS
+    sl::tinydir::create_directory(path);
+#else // !STATICLIB_WINDOWS
+    if (0 != ::mkdir(path.c_str(), 0777)) throw support::exception(TRACEMSG(
+            "Error creating directory, path: [" + path + "]," +
+            " error: [" + errno_str() + "]"));
+#endif // STATICLIB_WINDOWS
+}
+
+} // namespace
+
+const std::string& copy_method_name(copy_method method) {
+    static const std::string reflink = "reflink";
+    static const std::string copy_range = "copy_file_range";
+    static const std::string sendfile = "sendfile";
+    static const std::string stream = "stream";
+    switch (method) {
+    case copy_method::reflink: return reflink;
+    case copy_method::copy_range: return copy_range;
+    case copy_method::sendfile: return sendfile;
+    default: return stream;
+    }
+}
+
+copy_result copy_file_fast(const std::string& from, const std::string& to) {
+#ifdef STATICLIB_WINDOWS
+    sl::tinydir::path(from).copy_file(to);
+    auto st = file_stat();
+    stat_path(to, true, st);
+    return {copy_method::stream, st.size};
+#else // !STATICLIB_WINDOWS
+    fd_holder src(open_retry(from, O_RDONLY, 0));
+    if (-1 == src.get()) throw support::exception(TRACEMSG(
+            "Error opening file, path: [" + from + "]," +
+            " error: [" + errno_str() + "]"));
+    struct stat st;
+    if (0 != ::fstat(src.get(), std::addressof(st))) throw support::exception(TRACEMSG(
+            "Error accessing file, path: [" + from + "]," +
+            " error: [" + errno_str() + "]"));
+    if (!S_ISREG(st.st_mode)) throw support::exception(TRACEMSG(
+            "Source path is not a regular file, path: [" + from + "]"));
+    struct stat dst_st;
+    if (0 == ::stat(to.c_str(), std::addressof(dst_st)) &&
+            st.st_dev == dst_st.st_dev && st.st_ino == dst_st.st_ino) {
+        throw support::exception(TRACEMSG(
+                "Source and destination are the same file, path: [" + to + "]"));
+    }
+    fd_holder dst(open_retry(to, O_WRONLY | O_CREAT | O_TRUNC, st.st_mode & 0777));
+    if (-1 == dst.get()) throw support::exception(TRACEMSG(
+            "Error opening file, path: [" + to + "]," +
+            " error: [" + errno_str() + "]"));
+    auto size = static_cast<uint64_t>(st.st_size);
+#ifdef STATICLIB_LINUX
+    // shares extents on btrfs/xfs, no data is copied
+    if (size > 0 && 0 == ::ioctl(dst.get(), FICLONE, src.get())) {
+        return {copy_method::reflink, size};
+    }
+#endif // STATICLIB_LINUX
+    if (0 == size) {
+        // special files report zero size and are copied until EOF
+        auto cs = copy_state{src.get(), dst.get(), from, to, copy_method::stream};
+        auto bytes = copy_segment(cs, 0, 0, std::numeric_limits<uint64_t>::max());
+        return {cs.method, bytes};
+    }
+    auto cs = copy_state{src.get(), dst.get(), from, to, copy_method::copy_range};
+    uint64_t bytes = 0;
+    uint64_t pos = 0;
+    while (pos < size) {
+        auto data = static_cast<uint64_t>(pos);
+        auto hole = size;
+#ifdef SEEK_DATA
+        auto data_off = ::lseek(src.get(), static_cast<off_t>(pos), SEEK_DATA);
+        if (static_cast<off_t>(-1) == data_off) {
+            if (ENXIO == errno) {
+                // only a hole till the end
+                break;
+            }
+            // EINVAL - holes are not supported, copy the rest as data
+        } else {
+            data = static_cast<uint64_t>(data_off);
+            auto hole_off = ::lseek(src.get(), data_off, SEEK_HOLE);
+            if (static_cast<off_t>(-1) != hole_off) {
+                hole = std::min(size, static_cast<uint64_t>(hole_off));
+            }
+        }
+#endif // SEEK_DATA
+        if (hole <= data) {
+            break;
+        }
+        auto copied = copy_segment(cs, data, data, hole - data);
+        bytes += copied;
+        if (copied < hole - data) throw support::exception(TRACEMSG(
+                "File was truncated during copy, path: [" + from + "]"));
+        pos = hole;
+    }
+    // trailing hole
+    if (0 != ::ftruncate(dst.get(), static_cast<off_t>(size))) throw support::exception(TRACEMSG(
+            "Error resizing file, path: [" + to + "]," +
+            " error: [" + errno_str() + "]"));
+    return {cs.method, bytes};
+#endif // STATICLIB_WINDOWS
+}
+
+copy_result copy_file_region(const std::string& from, uint64_t from_offset, uint64_t length,
+        const std::string& to, uint64_t to_offset) {
+#ifdef STATICLIB_WINDOWS
+    auto src = sl::tinydir::file_source(from);
+    src.seek(static_cast<int64_t>(from_offset));
+    auto dest = sl::tinydir::path(to).open_write(sl::tinydir::file_sink::open_mode::from_file);
+    dest.seek(static_cast<int64_t>(to_offset));
+    auto buf = std::unique_ptr<char[]>(new char[1 << 18]);
+    uint64_t bytes = 0;
+    while (bytes < length) {
+        auto chunk = static_cast<size_t>(std::min(length - bytes, static_cast<uint64_t>(1 << 18)));
+        auto read = src.read({buf.get(), chunk});
+        if (read <= 0) {
+            break;
+        }
+        sl::io::write_all(dest, {buf.get(), static_cast<size_t>(read)});
+        bytes += static_cast<uint64_t>(read);
+    }
+    return {copy_method::stream, bytes};
+#else // !STATICLIB_WINDOWS
+    fd_holder src(open_retry(from, O_RDONLY, 0));
+    if (-1 == src.get()) throw support::exception(TRACEMSG(
+            "Error opening file, path: [" + from + "]," +
+            " error: [" + errno_str() + "]"));
+    struct stat st;
+    if (0 != ::fstat(src.get(), std::addressof(st))) throw support::exception(TRACEMSG(
+            "Error accessing file, path: [" + from + "]," +
+            " error: [" + errno_str() + "]"));
+    // existing destination is written in place, not truncated
+    fd_holder dst(open_retry(to, O_WRONLY, 0));
+    if (-1 == dst.get()) throw support::exception(TRACEMSG(
+            "Error opening file, path: [" + to + "]," +
+            " error: [" + errno_str() + "]"));
+    struct stat dst_st;
+    if (0 != ::fstat(dst.get(), std::addressof(dst_st))) throw support::exception(TRACEMSG(
+            "Error accessing file, path: [" + to + "]," +
+            " error: [" + errno_str() + "]"));
+    if (st.st_dev == dst_st.st_dev && st.st_ino == dst_st.st_ino) throw support::exception(TRACEMSG(
+            "Source and destination are the same file, path: [" + to + "]"));
+    // special files report zero size and are copied until EOF
+    auto size = static_cast<uint64_t>(st.st_size);
+    if (S_ISREG(st.st_mode)) {
+        auto available = from_offset < size ? size - from_offset : 0;
+        length = std::min(length, available);
+    }
+    auto method = S_ISREG(st.st_mode) ? copy_method::copy_range : copy_method::stream;
+    auto cs = copy_state{src.get(), dst.get(), from, to, method};
+    auto bytes = copy_segment(cs, from_offset, to_offset, length);
+    return {cs.method, bytes};
+#endif // STATICLIB_WINDOWS
+}
+
+copy_tree_result copy_directory_tree(const std::string& from, const std::string& to, size_t threads) {
+    auto root_st = file_stat();
+    if (!stat_path(from, true, root_st) || entry_type::directory != root_st.type) {
+        throw support::exception(TRACEMSG(
+                "Source path is not a directory, path: [" + from + "]"));
+    }
+    auto dest_st = file_stat();
+    if (stat_path(to, false, dest_st)) throw support::exception(TRACEMSG(
+            "Destination path already exists, path: [" + to + "]"));
+    // list the whole tree first, so directories can be created before files
+    auto workers = std::max(threads, static_cast<size_t>(1));
+    auto collected = std::vector<std::vector<walk_entry>>();
+    collected.resize(workers);
+    dir_walker walker(from, walk_options(), workers, [&collected](size_t idx, walk_entry&& en) {
+        collected[idx].emplace_back(std::move(en));
+        return true;
+    });
+    auto pool = shared_task_pool();
+    pool->parallel_for(workers, workers, [&walker](size_t idx) {
+        walker.work(idx);
+    });
+    auto errors = walker.collected_errors();
+    if (!errors.empty()) throw support::exception(TRACEMSG(
+            "Error listing directory, path: [" + errors.front().path + "]," +
+            " error: [" + errors.front().message + "]"));
+    auto dirs = std::vector<walk_entry>();
+    auto others = std::vector<walk_entry>();
+    for (auto& vec : collected) {
+        for (auto& en : vec) {
+            if (entry_type::directory == en.type) {
+                dirs.emplace_back(std::move(en));
+            } else {
+                others.emplace_back(std::move(en));
+            }
+        }
+    }
+    std::sort(dirs.begin(), dirs.end(), [](const walk_entry& a, const walk_entry& b) {
+        return a.depth < b.depth;
+    });
+    create_dir(to);
+    for (auto& en : dirs) {
+        create_dir(to + "/" + en.path);
+    }
+    // copy files
+    std::atomic<uint64_t> files{0};
+    std::atomic<uint64_t> symlinks{0};
+    std::atomic<uint64_t> bytes{0};
+    pool->parallel_for(others.size(), workers, [&](size_t idx) {
+        auto& en = others[idx];
+        auto src = from + "/" + en.path;
+        auto dst = to + "/" + en.path;
+        if (entry_type::file == en.type) {
+            auto res = copy_file_fast(src, dst);
+            files.fetch_add(1);
+            bytes.fetch_add(res.bytes);
+        }
+#ifndef STATICLIB_WINDOWS
+        else if (entry_type::symlink == en.type) {
+            auto target = std::string();
+            if (!read_symlink(src, target) || 0 != ::symlink(target.c_str(), dst.c_str())) {
+                throw support::exception(TRACEMSG(
+                        "Error copying symlink, path: [" + src + "]," +
+                        " error: [" + errno_str() + "]"));
+            }
+            symlinks.fetch_add(1);
+        }
+#endif // !STATICLIB_WINDOWS
+        // special files are skipped
+    });
+#ifndef STATICLIB_WINDOWS
+    // apply directory modes last, read-only directories must stay writable while copying
+    auto st = file_stat();
+    for (auto it = dirs.rbegin(); it != dirs.rend(); ++it) {
+        if (stat_path(from + "/" + it->path, false, st)) {
+            ::chmod((to + "/" + it->path).c_str(), st.mode & 07777);
+        }
+    }
+    ::chmod(to.c_str(), root_st.mode & 07777);
+#endif // !STATICLIB_WINDOWS
+    return {static_cast<uint64_t>(dirs.size()), files.load(), symlinks.load(), bytes.load()};
+}
+
+} // namespace
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   fast_copy.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_FAST_COPY_HPP
+#define WILTON_FS_FAST_COPY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "staticlib/config.hpp"
+
+namespace wilton {
+namespace fs {
+
+enum class copy_method {
+    reflink, copy_range, sendfile, stream
+};
+
+const std::string& copy_method_name(copy_method method);
+
+struct copy_result {
+    // the last method used, earlier data segments may be copied differently
+    copy_method method;
+    uint64_t bytes;
+};
+
+/**
+ * Copies a regular file, destination is created or truncated;
+ * tries reflink first, then in-kernel copy (`copy_file_range`,
+ * `sendfile`), then falls back to user-space copy; holes
+ * of sparse files are preserved
+ *
+ * @param from source file path
+ * @param to destination file path
+ * @return method used and number of data bytes
+ */
+copy_result copy_file_fast(const std::string& from, const std::string& to);
+
+/**
+ * Writes a region of one file into another one at the specified
+ * offset, destination must exist and is not truncated; data is
+ * spliced in kernel (`copy_file_range`, then `sendfile`) with
+ * fallback to user-space copy
+ *
+ * @param from source file path
+ * @param from_offset source region offset
+ * @param length max region length, copied until EOF of source if bigger
+ * @param to destination file path
+ * @param to_offset offset in destination
+ * @return method used and number of bytes written
+ */
+copy_result copy_file_region(const std::string& from, uint64_t from_offset, uint64_t length,
+        const std::string& to, uint64_t to_offset);
+
+struct copy_tree_result {
+    uint64_t directories;
+    uint64_t files;
+    uint64_t symlinks;
+    uint64_t bytes;
+};
+
+/**
+ * Recursive copy, destination must not exist; directory structure
+ * is created first, then files are copied in parallel on the shared
+ * task pool; symlinks are recreated, not followed
+ *
+ * @param from source directory
+ * @param to destination directory
+ * @param threads max parallelism, including the calling thread
+ * @return copied entries counts
+ */
+copy_tree_result copy_directory_tree(const std::string& from, const std::string& to, size_t threads);
+
+} // namespace
+}
+
+#endif /* WILTON_FS_FAST_COPY_HPP */
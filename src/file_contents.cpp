@@ -0,0 +1,153 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_contents.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "file_contents.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#ifdef STATICLIB_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h>
+#include <process.h>
+#else // !STATICLIB_WINDOWS
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif // STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "concurrent_writer.hpp"
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+std::string temp_path_for(const std::string& path) {
+    static std::atomic<uint64_t> counter{0};
+#ifdef STATICLIB_WINDOWS
+    auto pid = static_cast<uint64_t>(::_getpid());
+    auto sep = path.find_last_of("/\\");
+#else // !STATICLIB_WINDOWS
+    auto pid = static_cast<uint64_t>(::getpid());
+    auto sep = path.rfind('/');
+#endif // STATICLIB_WINDOWS
+    auto dir = std::string::npos != sep ? path.substr(0, sep + 1) : std::string();
+    auto name = std::string::npos != sep ? path.substr(sep + 1) : path;
+    return dir + "." + name + ".tmp-" + sl::support::to_string(pid) + "-" +
+            sl::support::to_string(counter.fetch_add(1));
+}
+
+void write_through_writer(const std::string& path, sl::io::span<const char> data, bool sync) {
+    auto opts = writer_options();
+    // data is written directly, without copying to buffer
+    opts.buffer_size = 1;
+    opts.sync = sync ? sync_mode::on_close : sync_mode::none;
+    auto writer = concurrent_writer::open(path, false, false, opts);
+    writer->write(data);
+    writer->close();
+}
+
+void replace_file(const std::string& from, const std::string& to) {
+#ifdef STATICLIB_WINDOWS
+    auto wfrom = sl::utils::widen(from);
+    auto wto = sl::utils::widen(to);
+    auto flags = MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH;
+    if (0 == ::MoveFileExW(wfrom.c_str(), wto.c_str(), flags)) throw support::exception(TRACEMSG(
+            "Error renaming file, from: [" + from + "], to: [" + to + "]," +
+            " error: [" + sl::support::to_string(::GetLastError()) + "]"));
+#else // !STATICLIB_WINDOWS
+    if (0 != ::rename(from.c_str(), to.c_str())) throw support::exception(TRACEMSG(
+            "Error renaming file, from: [" + from + "], to: [" + to + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+#endif // STATICLIB_WINDOWS
+}
+
+void remove_quietly(const std::string& path) {
+#ifdef STATICLIB_WINDOWS
+    auto wpath = sl::utils::widen(path);
+    ::_wremove(wpath.c_str());
+#else // !STATICLIB_WINDOWS
+    std::remove(path.c_str());
+#endif // STATICLIB_WINDOWS
+}
+
+#ifndef STATICLIB_WINDOWS
+void keep_target_mode(const std::string& temp, const std::string& target) {
+    struct stat st;
+    if (0 == ::stat(target.c_str(), std::addressof(st))) {
+        ::chmod(temp.c_str(), st.st_mode & 07777);
+    }
+}
+
+// makes rename durable
+void sync_parent_dir(const std::string& path) {
+    auto sep = path.rfind('/');
+    auto dir = std::string::npos != sep ? (0 == sep ? std::string("/") : path.substr(0, sep)) :
+            std::string(".");
+    auto fd = ::open(dir.c_str(), O_RDONLY | O_CLOEXEC);
+    if (-1 == fd) {
+        return;
+    }
+    ::fsync(fd);
+    ::close(fd);
+}
+#endif // !STATICLIB_WINDOWS
+
+} // namespace
+
+void write_file_contents(const std::string& path, sl::io::span<const char> data, bool atomic, bool sync) {
+    if (!atomic) {
+        write_through_writer(path, data, sync);
+        return;
+    }
+    auto temp = temp_path_for(path);
+    try {
+        write_through_writer(temp, data, sync);
+#ifndef STATICLIB_WINDOWS
+        keep_target_mode(temp, path);
+#endif // !STATICLIB_WINDOWS
+        replace_file(temp, path);
+    } catch (...) {
+        remove_quietly(temp);
+        throw;
+    }
+#ifndef STATICLIB_WINDOWS
+    if (sync) {
+        sync_parent_dir(path);
+    }
+#endif // !STATICLIB_WINDOWS
+}
+
+} // namespace
+}
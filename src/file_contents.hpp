@@ -0,0 +1,50 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_contents.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_FILE_CONTENTS_HPP
+#define WILTON_FS_FILE_CONTENTS_HPP
+
+#include <string>
+
+#include "staticlib/config.hpp"
+#include "staticlib/io.hpp"
+
+namespace wilton {
+namespace fs {
+
+/**
+ * Replaces file contents with a single write; in atomic mode data
+ * is written to a temporary file in the same directory that is
+ * renamed over the target, so readers never see partial contents
+ *
+ * @param path target file path
+ * @param data file contents
+ * @param atomic whether to write through a temporary file
+ * @param sync whether to sync data (and directory entry in atomic mode) to disk
+ */
+void write_file_contents(const std::string& path, sl::io::span<const char> data, bool atomic, bool sync);
+
+} // namespace
+}
+
+#endif /* WILTON_FS_FILE_CONTENTS_HPP */
@@ -0,0 +1,367 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_grep.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "file_grep.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <regex>
+
+#include "staticlib/support.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "native_file.hpp"
+#include "search_simd.hpp"
+#include "task_pool.hpp"
+#include "utf8_simd.hpp"
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+// bigger files are split into chunks searched in parallel
+const uint64_t chunk_size = 16 << 20;
+// chunk is extended by these steps to the end of its last line
+const size_t extend_step = 64 << 10;
+
+struct region_result {
+    std::vector<grep_match> matches;
+    uint64_t newlines = 0;
+    bool complete = true;
+};
+
+struct big_file {
+    size_t file;
+    // size at open, later appends are not searched
+    uint64_t size;
+    std::unique_ptr<native_file> handle;
+    // in chunks order
+    std::vector<region_result> chunks;
+};
+
+class grep_context {
+    const grep_options& opts;
+    std::regex re;
+    std::atomic<size_t> found;
+
+public:
+    explicit grep_context(const grep_options& options) :
+    opts(options),
+    found(0) {
+        if (opts.regex) {
+            try {
+                this->re = std::regex(opts.pattern, std::regex::ECMAScript | std::regex::optimize);
+            } catch (const std::regex_error& e) {
+                throw support::exception(TRACEMSG("Invalid regular expression specified," +
+                        " pattern: [" + opts.pattern + "], error: [" + e.what() + "]"));
+            }
+        } else if (nullptr != std::memchr(opts.pattern.data(), '\n', opts.pattern.length())) {
+            throw support::exception(TRACEMSG("Search pattern must not contain line breaks"));
+        }
+    }
+
+    grep_context(const grep_context&) = delete;
+
+    grep_context& operator=(const grep_context&) = delete;
+
+    bool stopped() const {
+        return found.load(std::memory_order_relaxed) >= opts.max_matches;
+    }
+
+    // region must start at a line start, line numbers and offsets are relative to it
+    void search(size_t file, const char* begin, const char* end, region_result& res) {
+        if (opts.regex) {
+            search_regex(file, begin, end, res);
+        } else {
+            search_fixed(file, begin, end, res);
+        }
+    }
+
+private:
+    void search_fixed(size_t file, const char* begin, const char* end, region_result& res) {
+        auto pos = begin;
+        auto counted = begin;
+        while (pos < end) {
+            auto hit = find_substring(pos, static_cast<size_t>(end - pos),
+                    opts.pattern.data(), opts.pattern.length());
+            if (nullptr == hit) {
+                break;
+            }
+            auto line_start = hit;
+            while (line_start > pos && '\n' != line_start[-1]) {
+                line_start -= 1;
+            }
+            auto line_end = line_end_of(hit, end);
+            res.newlines += count_byte(counted, static_cast<size_t>(line_start - counted), '\n');
+            counted = line_start;
+            if (!emit(file, begin, line_start, line_end, res)) {
+                return;
+            }
+            pos = line_end < end ? line_end + 1 : end;
+        }
+        if (counted < end) {
+            res.newlines += count_byte(counted, static_cast<size_t>(end - counted), '\n');
+        }
+    }
+
+    void search_regex(size_t file, const char* begin, const char* end, region_result& res) {
+        auto pos = begin;
+        while (pos < end) {
+            auto line_end = line_end_of(pos, end);
+            auto text_end = trim_cr(pos, line_end);
+            if (std::regex_search(pos, text_end, re)) {
+                if (!emit(file, begin, pos, line_end, res)) {
+                    return;
+                }
+            }
+            if (line_end == end) {
+                break;
+            }
+            res.newlines += 1;
+            pos = line_end + 1;
+        }
+    }
+
+    bool emit(size_t file, const char* begin, const char* line_start, const char* line_end,
+            region_result& res) {
+        if (found.fetch_add(1) >= opts.max_matches) {
+            res.complete = false;
+            return false;
+        }
+        auto text_end = trim_cr(line_start, line_end);
+        auto len = static_cast<size_t>(text_end - line_start);
+        auto text = std::string();
+        if (utf8_is_valid(line_start, len)) {
+            text.assign(line_start, len);
+        } else {
+            utf8_replace_invalid(line_start, len, text);
+        }
+        res.matches.push_back({file, res.newlines, static_cast<uint64_t>(line_start - begin), std::move(text)});
+        return true;
+    }
+
+    static const char* line_end_of(const char* pos, const char* end) {
+        auto nl = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+        return nullptr != nl ? nl : end;
+    }
+
+    static const char* trim_cr(const char* line_start, const char* line_end) {
+        return line_end > line_start && '\r' == line_end[-1] ? line_end - 1 : line_end;
+    }
+};
+
+// whole contents up to EOF, size is not trusted for special files
+std::string read_small_file(const native_file& file, uint64_t size_hint) {
+    auto str = std::string();
+    str.resize(static_cast<size_t>(size_hint) + 1);
+    size_t len = 0;
+    for (;;) {
+        len += file.read_at(std::addressof(str.front()) + len, str.length() - len, len);
+        if (len < str.length()) {
+            break;
+        }
+        str.resize(str.length() * 2);
+    }
+    str.resize(len);
+    return str;
+}
+
+void read_exactly(const native_file& file, char* buf, size_t len, uint64_t offset) {
+    auto read = file.read_at(buf, len, offset);
+    if (read < len) throw support::exception(TRACEMSG(
+            "File was truncated during search, path: [" + file.path() + "]"));
+}
+
+// searches lines starting in [offset, offset + length), the byte before
+// the chunk tells whether it starts at a line start, the last line is
+// read past the chunk end; offsets of matches are absolute;
+// returns number of bytes read
+uint64_t search_chunk(grep_context& ctx, size_t file_idx, const native_file& file, uint64_t file_size,
+        uint64_t offset, uint64_t length, region_result& res) {
+    auto read_from = offset > 0 ? offset - 1 : 0;
+    auto buf = std::string();
+    buf.resize(static_cast<size_t>(offset + length - read_from));
+    read_exactly(file, std::addressof(buf.front()), buf.length(), read_from);
+    uint64_t bytes = buf.length();
+    size_t begin = 0;
+    if (offset > 0) {
+        auto nl = std::memchr(buf.data(), '\n', buf.length());
+        if (nullptr == nl) {
+            // whole chunk belongs to a line started earlier
+            return bytes;
+        }
+        begin = static_cast<size_t>(static_cast<const char*>(nl) - buf.data()) + 1;
+    }
+    // last byte of the chunk may already be the line end
+    auto tail = buf.length() - 1;
+    for (;;) {
+        auto nl = std::memchr(buf.data() + tail, '\n', buf.length() - tail);
+        if (nullptr != nl) {
+            buf.resize(static_cast<size_t>(static_cast<const char*>(nl) - buf.data()) + 1);
+            break;
+        }
+        auto pos = read_from + buf.length();
+        if (pos >= file_size) {
+            break;
+        }
+        tail = buf.length();
+        auto len = static_cast<size_t>(std::min(file_size - pos, static_cast<uint64_t>(extend_step)));
+        buf.resize(tail + len);
+        read_exactly(file, std::addressof(buf[tail]), len, pos);
+        bytes += len;
+    }
+    if (begin < buf.length()) {
+        ctx.search(file_idx, buf.data() + begin, buf.data() + buf.length(), res);
+    }
+    for (auto& ma : res.matches) {
+        ma.offset += read_from + begin;
+    }
+    return bytes;
+}
+
+void append_region(region_result& res, uint64_t line_base, uint64_t offset_base,
+        std::vector<grep_match>& out) {
+    for (auto& ma : res.matches) {
+        ma.line += line_base + 1;
+        ma.offset += offset_base;
+        out.emplace_back(std::move(ma));
+    }
+}
+
+} // namespace
+
+grep_result grep_files(const std::vector<std::string>& paths, const grep_options& options,
+        size_t max_workers) {
+    grep_context ctx(options);
+    auto pool = shared_task_pool();
+    auto results = std::vector<region_result>(paths.size());
+    auto errors = std::vector<std::unique_ptr<grep_error>>(paths.size());
+    std::mutex big_mutex;
+    auto bigs = std::vector<big_file>();
+    // pool threads are not measured, bytes are returned to the caller
+    std::atomic<uint64_t> bytes(0);
+    // small and medium files are searched whole, big ones are split into chunks;
+    // files are never mapped, so truncation during search cannot crash the process
+    pool->parallel_for(paths.size(), max_workers, [&](size_t idx) {
+        if (ctx.stopped()) {
+            results[idx].complete = false;
+            return;
+        }
+        try {
+            auto file = native_file::open_read(paths[idx]);
+            auto size = file.size();
+            if (size <= chunk_size) {
+                auto contents = read_small_file(file, size);
+                bytes.fetch_add(contents.length(), std::memory_order_relaxed);
+                auto data = contents.data();
+                ctx.search(idx, data, data + contents.length(), results[idx]);
+            } else {
+                // descriptor is kept, so rotation of the path does not affect the search
+                auto handle = std::unique_ptr<native_file>(new native_file(std::move(file)));
+                std::lock_guard<std::mutex> guard{big_mutex};
+                bigs.push_back({idx, size, std::move(handle), std::vector<region_result>()});
+            }
+        } catch (const std::exception& e) {
+            errors[idx] = std::unique_ptr<grep_error>(new grep_error{paths[idx], e.what()});
+        }
+    });
+    // chunks of all big files share the pool
+    auto units = std::vector<std::pair<size_t, size_t>>();
+    for (size_t i = 0; i < bigs.size(); i++) {
+        auto size = bigs[i].size;
+        auto count = static_cast<size_t>((size + chunk_size - 1) / chunk_size);
+        bigs[i].chunks.resize(count);
+        for (size_t c = 0; c < count; c++) {
+            units.emplace_back(i, c);
+        }
+    }
+    pool->parallel_for(units.size(), max_workers, [&](size_t idx) {
+        auto& bf = bigs[units[idx].first];
+        auto& res = bf.chunks[units[idx].second];
+        if (ctx.stopped()) {
+            res.complete = false;
+            return;
+        }
+        auto chunk_start = static_cast<uint64_t>(units[idx].second) * chunk_size;
+        auto length = std::min(chunk_size, bf.size - chunk_start);
+        try {
+#ifdef STATICLIB_WINDOWS
+            // descriptors are not shared, positioned reads are emulated on Windows
+            auto file = native_file::open_read(paths[bf.file]);
+            bytes.fetch_add(search_chunk(ctx, bf.file, file, bf.size, chunk_start, length, res),
+                    std::memory_order_relaxed);
+#else // !STATICLIB_WINDOWS
+            bytes.fetch_add(search_chunk(ctx, bf.file, *bf.handle, bf.size, chunk_start, length, res),
+                    std::memory_order_relaxed);
+#endif // STATICLIB_WINDOWS
+        } catch (const std::exception& e) {
+            res.matches.clear();
+            res.complete = false;
+            std::lock_guard<std::mutex> guard{big_mutex};
+            if (nullptr == errors[bf.file]) {
+                errors[bf.file] = std::unique_ptr<grep_error>(new grep_error{paths[bf.file], e.what()});
+            }
+        }
+    });
+    // merge in input order
+    auto big_idx = std::vector<big_file*>(paths.size(), nullptr);
+    for (auto& bf : bigs) {
+        big_idx[bf.file] = std::addressof(bf);
+    }
+    auto res = grep_result();
+    res.truncated = false;
+    res.bytes_read = bytes.load();
+    for (size_t i = 0; i < paths.size(); i++) {
+        if (nullptr != errors[i]) {
+            res.errors.emplace_back(std::move(*errors[i]));
+        }
+        if (nullptr == big_idx[i]) {
+            res.truncated = res.truncated || !results[i].complete;
+            append_region(results[i], 0, 0, res.matches);
+            continue;
+        }
+        // line numbers depend on all preceding chunks being fully searched
+        uint64_t line_base = 0;
+        for (auto& ch : big_idx[i]->chunks) {
+            append_region(ch, line_base, 0, res.matches);
+            line_base += ch.newlines;
+            if (!ch.complete) {
+                res.truncated = true;
+                break;
+            }
+        }
+    }
+    if (res.matches.size() > options.max_matches) {
+        res.matches.resize(options.max_matches);
+        res.truncated = true;
+    }
+    return res;
+}
+
+} // namespace
+}
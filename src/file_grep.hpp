@@ -0,0 +1,88 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_grep.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_FILE_GREP_HPP
+#define WILTON_FS_FILE_GREP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace wilton {
+namespace fs {
+
+struct grep_options {
+    std::string pattern;
+    // ECMAScript regular expression, literal substring otherwise
+    bool regex;
+    size_t max_matches;
+
+    grep_options() :
+    regex(false),
+    max_matches(1000) { }
+};
+
+struct grep_match {
+    // index in the input paths list
+    size_t file;
+    // 1-based
+    uint64_t line;
+    // byte offset of the line start
+    uint64_t offset;
+    // without line terminator, invalid UTF-8 is replaced
+    std::string text;
+};
+
+struct grep_error {
+    std::string path;
+    std::string message;
+};
+
+struct grep_result {
+    std::vector<grep_match> matches;
+    std::vector<grep_error> errors;
+    bool truncated;
+    // read by all workers, for metrics
+    uint64_t bytes_read;
+};
+
+/**
+ * Finds lines matching the pattern; files are distributed over
+ * the shared pool, big files are read with positioned reads in
+ * line-aligned chunks that are searched in parallel; matches are
+ * returned in input order, when the limit is reached the subset
+ * of returned matches is not deterministic
+ *
+ * @param paths files to search
+ * @param options search options
+ * @param max_workers parallelism limit, including the calling thread
+ * @return matches and per-file errors
+ */
+grep_result grep_files(const std::vector<std::string>& paths, const grep_options& options,
+        size_t max_workers);
+
+} // namespace
+}
+
+#endif /* WILTON_FS_FILE_GREP_HPP */
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_hash.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "file_hash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "wilton/support/exception.hpp"
+
+#include "crc32c_simd.hpp"
+#include "hex_simd.hpp"
+#include "native_file.hpp"
+#include "sha256.hpp"
+#include "task_pool.hpp"
+#include "xxh3_simd.hpp"
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+const size_t read_block_size = 1 << 20;
+const uint64_t min_chunk_size = 16 << 20;
+
+// calls `fun` for each block read, returns number of bytes read
+template<typename Fun>
+uint64_t read_blocks(const native_file& file, uint64_t offset, uint64_t length, Fun fun) {
+    auto buf = std::string();
+    buf.resize(static_cast<size_t>(std::min(length, static_cast<uint64_t>(read_block_size))));
+    uint64_t done = 0;
+    while (done < length) {
+        auto len = static_cast<size_t>(std::min(length - done, static_cast<uint64_t>(buf.length())));
+        auto read = file.read_at(std::addressof(buf.front()), len, offset + done);
+        fun(buf.data(), read);
+        done += read;
+        if (read < len) {
+            break;
+        }
+    }
+    return done;
+}
+
+std::string hex_digest(const uint8_t* bytes, size_t len) {
+    auto res = std::string();
+    res.resize(len * 2);
+    hex_encode(reinterpret_cast<const char*>(bytes), len, std::addressof(res.front()));
+    return res;
+}
+
+std::string hex_digest(uint64_t value, size_t bytes_count) {
+    std::array<uint8_t, 8> bytes;
+    for (size_t i = 0; i < bytes_count; i++) {
+        bytes[i] = static_cast<uint8_t>(value >> ((bytes_count - 1 - i) * 8));
+    }
+    return hex_digest(bytes.data(), bytes_count);
+}
+
+hash_result hash_crc32c_parallel(const std::string& path, uint64_t offset, uint64_t length,
+        size_t max_workers) {
+    // more chunks than workers to even out uneven read speed
+    auto chunk_size = std::max(min_chunk_size, (length + max_workers * 4 - 1) / (max_workers * 4));
+    auto count = static_cast<size_t>((length + chunk_size - 1) / chunk_size);
+    auto crcs = std::vector<uint32_t>(count);
+    auto lens = std::vector<uint64_t>(count);
+    shared_task_pool()->parallel_for(count, max_workers, [&](size_t idx) {
+        // descriptors are not shared, positioned reads are emulated on Windows
+        auto file = native_file::open_read(path);
+        auto chunk_offset = idx * chunk_size;
+        auto chunk_len = std::min(chunk_size, length - chunk_offset);
+        uint32_t crc = 0;
+        lens[idx] = read_blocks(file, offset + chunk_offset, chunk_len, [&crc](const char* data, size_t len) {
+            crc = crc32c_update(crc, data, len);
+        });
+        crcs[idx] = crc;
+    });
+    uint32_t crc = crcs.front();
+    uint64_t total = lens.front();
+    for (size_t i = 1; i < count; i++) {
+        if (lens[i - 1] != chunk_size) throw support::exception(TRACEMSG(
+                "File was truncated during hashing, path: [" + path + "]"));
+        crc = crc32c_combine(crc, crcs[i], lens[i]);
+        total += lens[i];
+    }
+    return {hex_digest(crc, 4), total};
+}
+
+} // namespace
+
+hash_algo parse_hash_algo(const std::string& name) {
+    if ("crc32c" == name) {
+        return hash_algo::crc32c;
+    } else if ("xxh3" == name) {
+        return hash_algo::xxh3;
+    } else if ("sha256" == name) {
+        return hash_algo::sha256;
+    }
+    throw support::exception(TRACEMSG("Invalid hash algorithm specified: [" + name + "]," +
+            " supported algorithms: [crc32c, xxh3, sha256]"));
+}
+
+hash_result hash_file(const std::string& path, hash_algo algo, uint64_t offset, uint64_t length,
+        size_t max_workers) {
+    auto file = native_file::open_read(path);
+    if (hash_algo::crc32c == algo && max_workers > 1) {
+        // special files report zero size and are read sequentially below
+        auto size = file.size();
+        auto available = offset < size ? size - offset : 0;
+        auto len = std::min(length, available);
+        if (len >= min_chunk_size * 2) {
+            return hash_crc32c_parallel(path, offset, len, max_workers);
+        }
+    }
+    switch (algo) {
+    case hash_algo::crc32c: {
+        uint32_t crc = 0;
+        auto read = read_blocks(file, offset, length, [&crc](const char* data, size_t len) {
+            crc = crc32c_update(crc, data, len);
+        });
+        return {hex_digest(crc, 4), read};
+    }
+    case hash_algo::xxh3: {
+        xxh3_state st;
+        auto read = read_blocks(file, offset, length, [&st](const char* data, size_t len) {
+            st.update(data, len);
+        });
+        return {hex_digest(st.digest(), 8), read};
+    }
+    default: {
+        sha256_state st;
+        auto read = read_blocks(file, offset, length, [&st](const char* data, size_t len) {
+            st.update(data, len);
+        });
+        auto dig = st.digest();
+        return {hex_digest(dig.data(), dig.size()), read};
+    }
+    }
+}
+
+} // namespace
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_hash.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_FILE_HASH_HPP
+#define WILTON_FS_FILE_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace wilton {
+namespace fs {
+
+enum class hash_algo {
+    crc32c, xxh3, sha256
+};
+
+/**
+ * Parses algorithm name: "crc32c", "xxh3" (64-bit) or "sha256"
+ *
+ * @param name algorithm name
+ * @return algorithm
+ */
+hash_algo parse_hash_algo(const std::string& name);
+
+struct hash_result {
+    // lowercase hex, checksums are printed as big-endian numbers
+    std::string digest;
+    uint64_t size;
+};
+
+/**
+ * Hashes a file region reading it in large blocks; big regions are
+ * split into chunks hashed in parallel when the algorithm allows
+ * combining partial results (crc32c), other algorithms are sequential
+ *
+ * @param path file path
+ * @param algo hash algorithm
+ * @param offset region start
+ * @param length region length, hashed up to EOF if the file is shorter
+ * @param max_workers parallelism limit for chunked hashing, including the calling thread
+ * @return digest and number of bytes hashed
+ */
+hash_result hash_file(const std::string& path, hash_algo algo, uint64_t offset, uint64_t length,
+        size_t max_workers);
+
+} // namespace
+}
+
+#endif /* WILTON_FS_FILE_HASH_HPP */
@@ -0,0 +1,186 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_space.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "file_space.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+#ifdef STATICLIB_WINDOWS
+#include <io.h>
+#include <fcntl.h>
+#include <share.h>
+#include <sys/stat.h>
+#else // !STATICLIB_WINDOWS
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif // STATICLIB_WINDOWS
+
+#ifdef STATICLIB_LINUX
+#include <linux/falloc.h>
+#endif // STATICLIB_LINUX
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "wilton/support/exception.hpp"
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+std::string errno_str(int err) {
+    return std::string(::strerror(err));
+}
+
+// existing file is opened for writing without truncation
+class write_fd {
+    int fd;
+
+public:
+    explicit write_fd(const std::string& path) :
+    fd(-1) {
+#ifdef STATICLIB_WINDOWS
+        auto wpath = sl::utils::widen(path);
+        auto err = ::_wsopen_s(std::addressof(fd), wpath.c_str(), _O_WRONLY | _O_BINARY,
+                _SH_DENYNO, _S_IREAD | _S_IWRITE);
+        if (0 != err) throw support::exception(TRACEMSG(
+                "Error opening file, path: [" + path + "]," +
+                " error: [" + errno_str(err) + "]"));
+#else // !STATICLIB_WINDOWS
+        do {
+            fd = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+        } while (-1 == fd && EINTR == errno);
+        if (-1 == fd) throw support::exception(TRACEMSG(
+                "Error opening file, path: [" + path + "]," +
+                " error: [" + errno_str(errno) + "]"));
+#endif // STATICLIB_WINDOWS
+    }
+
+    write_fd(const write_fd&) = delete;
+
+    write_fd& operator=(const write_fd&) = delete;
+
+    ~write_fd() {
+#ifdef STATICLIB_WINDOWS
+        ::_close(fd);
+#else // !STATICLIB_WINDOWS
+        ::close(fd);
+#endif // STATICLIB_WINDOWS
+    }
+
+    int get() const {
+        return fd;
+    }
+};
+
+void check_off_range(const std::string& path, uint64_t value) {
+    if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+        throw support::exception(TRACEMSG("Invalid file offset specified," +
+                " path: [" + path + "], offset: [" + sl::support::to_string(value) + "]"));
+    }
+}
+
+#ifdef STATICLIB_LINUX
+// returns errno, 0 on success
+int allocate_range(int fd, uint64_t offset, uint64_t length) {
+    for (;;) {
+        // extends file size, unlike KEEP_SIZE preallocation of writers
+        if (0 == ::fallocate(fd, 0, static_cast<off_t>(offset), static_cast<off_t>(length))) {
+            return 0;
+        }
+        if (EINTR == errno) continue;
+        if (EOPNOTSUPP != errno) return errno;
+        // emulated by glibc with writes of zero bytes to each block
+        return ::posix_fallocate(fd, static_cast<off_t>(offset), static_cast<off_t>(length));
+    }
+}
+#endif // STATICLIB_LINUX
+
+} // namespace
+
+void resize_file_space(const std::string& path, uint64_t size, bool allocate) {
+    check_off_range(path, size);
+    write_fd fd(path);
+#ifdef STATICLIB_WINDOWS
+    if (allocate) throw support::exception(TRACEMSG(
+            "Block allocation is not supported on this platform, path: [" + path + "]"));
+    auto err = ::_chsize_s(fd.get(), static_cast<__int64>(size));
+#else // !STATICLIB_WINDOWS
+    struct stat st;
+    if (0 != ::fstat(fd.get(), std::addressof(st))) throw support::exception(TRACEMSG(
+            "Error accessing file, path: [" + path + "]," +
+            " error: [" + errno_str(errno) + "]"));
+    auto current = static_cast<uint64_t>(st.st_size);
+    auto err = 0;
+    if (allocate && size > current) {
+#ifdef STATICLIB_LINUX
+        err = allocate_range(fd.get(), current, size - current);
+#else // !STATICLIB_LINUX
+        throw support::exception(TRACEMSG(
+                "Block allocation is not supported on this platform, path: [" + path + "]"));
+#endif // STATICLIB_LINUX
+    } else if (0 != ::ftruncate(fd.get(), static_cast<off_t>(size))) {
+        err = errno;
+    }
+#endif // STATICLIB_WINDOWS
+    if (0 != err) throw support::exception(TRACEMSG(
+            "Error resizing file, path: [" + path + "]," +
+            " size: [" + sl::support::to_string(size) + "]," +
+            " error: [" + errno_str(err) + "]"));
+}
+
+void punch_file_holes(const std::string& path, const std::vector<file_range>& ranges) {
+#ifdef STATICLIB_LINUX
+    write_fd fd(path);
+    for (auto& ra : ranges) {
+        check_off_range(path, ra.offset);
+        check_off_range(path, ra.length);
+        if (0 == ra.length) {
+            continue;
+        }
+        auto res = 0;
+        do {
+            res = ::fallocate(fd.get(), FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                    static_cast<off_t>(ra.offset), static_cast<off_t>(ra.length));
+        } while (0 != res && EINTR == errno);
+        if (0 != res) throw support::exception(TRACEMSG(
+                "Error punching hole, path: [" + path + "]," +
+                " offset: [" + sl::support::to_string(ra.offset) + "]," +
+                " length: [" + sl::support::to_string(ra.length) + "]," +
+                " error: [" + errno_str(errno) + "]"));
+    }
+#else // !STATICLIB_LINUX
+    (void) ranges;
+    throw support::exception(TRACEMSG(
+            "Punching holes is not supported on this platform, path: [" + path + "]"));
+#endif // STATICLIB_LINUX
+}
+
+} // namespace
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_space.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_FILE_SPACE_HPP
+#define WILTON_FS_FILE_SPACE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "staticlib/config.hpp"
+
+namespace wilton {
+namespace fs {
+
+struct file_range {
+    uint64_t offset;
+    uint64_t length;
+};
+
+/**
+ * Sets file size with 64-bit precision; growth is sparse by default,
+ * in allocate mode blocks for the new region are reserved with
+ * `fallocate` (Linux only), so later writes into it cannot fail
+ * with ENOSPC
+ *
+ * @param path existing file path
+ * @param size new size
+ * @param allocate whether to allocate blocks on growth
+ */
+void resize_file_space(const std::string& path, uint64_t size, bool allocate);
+
+/**
+ * Deallocates blocks of the specified ranges keeping file size,
+ * ranges read back as zeros (Linux only)
+ *
+ * @param path existing file path
+ * @param ranges ranges to deallocate
+ */
+void punch_file_holes(const std::string& path, const std::vector<file_range>& ranges);
+
+} // namespace
+}
+
+#endif /* WILTON_FS_FILE_SPACE_HPP */
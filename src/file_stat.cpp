@@ -0,0 +1,136 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_stat.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "file_stat.hpp"
+
+#include <memory>
+
+#ifdef STATICLIB_WINDOWS
+#include <sys/stat.h>
+#include <sys/types.h>
+#else // !STATICLIB_WINDOWS
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif // STATICLIB_WINDOWS
+
+#include "staticlib/utils.hpp"
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+#ifdef STATICLIB_WINDOWS
+
+void fill_stat(const struct _stat64& st, file_stat& out) {
+    out.type = 0 != (st.st_mode & _S_IFREG) ? entry_type::file :
+            0 != (st.st_mode & _S_IFDIR) ? entry_type::directory : entry_type::other;
+    out.size = static_cast<uint64_t>(st.st_size);
+    out.mtime = static_cast<int64_t>(st.st_mtime) * 1000;
+    out.ctime = static_cast<int64_t>(st.st_ctime) * 1000;
+    out.mode = static_cast<uint32_t>(st.st_mode);
+    out.dev = static_cast<uint64_t>(st.st_dev);
+    out.inode = static_cast<uint64_t>(st.st_ino);
+    out.nlink = static_cast<uint64_t>(st.st_nlink);
+}
+
+#else // !STATICLIB_WINDOWS
+
+int64_t to_millis(const struct timespec& ts) {
+    return static_cast<int64_t>(ts.tv_sec) * 1000 + static_cast<int64_t>(ts.tv_nsec) / 1000000;
+}
+
+void fill_stat(const struct stat& st, file_stat& out) {
+    out.type = S_ISREG(st.st_mode) ? entry_type::file :
+            S_ISDIR(st.st_mode) ? entry_type::directory :
+            S_ISLNK(st.st_mode) ? entry_type::symlink : entry_type::other;
+    out.size = static_cast<uint64_t>(st.st_size);
+#ifdef STATICLIB_MAC
+    out.mtime = to_millis(st.st_mtimespec);
+    out.ctime = to_millis(st.st_ctimespec);
+#else // !STATICLIB_MAC
+    out.mtime = to_millis(st.st_mtim);
+    out.ctime = to_millis(st.st_ctim);
+#endif // STATICLIB_MAC
+    out.mode = static_cast<uint32_t>(st.st_mode);
+    out.dev = static_cast<uint64_t>(st.st_dev);
+    out.inode = static_cast<uint64_t>(st.st_ino);
+    out.nlink = static_cast<uint64_t>(st.st_nlink);
+}
+
+#endif // STATICLIB_WINDOWS
+
+} // namespace
+
+bool stat_path(const std::string& path, bool follow_symlinks, file_stat& out) {
+#ifdef STATICLIB_WINDOWS
+    (void) follow_symlinks;
+    struct _stat64 st;
+    auto wpath = sl::utils::widen(path);
+    if (0 != ::_wstat64(wpath.c_str(), std::addressof(st))) {
+        return false;
+    }
+#else // !STATICLIB_WINDOWS
+    struct stat st;
+    auto err = follow_symlinks ?
+            ::stat(path.c_str(), std::addressof(st)) :
+            ::lstat(path.c_str(), std::addressof(st));
+    if (0 != err) {
+        return false;
+    }
+#endif // STATICLIB_WINDOWS
+    fill_stat(st, out);
+    return true;
+}
+
+bool stat_handle(int fd, file_stat& out) {
+#ifdef STATICLIB_WINDOWS
+    struct _stat64 st;
+    if (0 != ::_fstat64(fd, std::addressof(st))) {
+        return false;
+    }
+#else // !STATICLIB_WINDOWS
+    struct stat st;
+    if (0 != ::fstat(fd, std::addressof(st))) {
+        return false;
+    }
+#endif // STATICLIB_WINDOWS
+    fill_stat(st, out);
+    return true;
+}
+
+#ifndef STATICLIB_WINDOWS
+bool stat_at(int dir_fd, const std::string& name, bool follow_symlinks, file_stat& out) {
+    struct stat st;
+    auto flags = follow_symlinks ? 0 : AT_SYMLINK_NOFOLLOW;
+    if (0 != ::fstatat(dir_fd, name.c_str(), std::addressof(st), flags)) {
+        return false;
+    }
+    fill_stat(st, out);
+    return true;
+}
+#endif // !STATICLIB_WINDOWS
+
+} // namespace
+}
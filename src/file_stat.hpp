@@ -0,0 +1,85 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_stat.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_FILE_STAT_HPP
+#define WILTON_FS_FILE_STAT_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "staticlib/config.hpp"
+
+#include "dir_reader.hpp"
+
+namespace wilton {
+namespace fs {
+
+struct file_stat {
+    entry_type type;
+    uint64_t size;
+    // milliseconds since epoch
+    int64_t mtime;
+    int64_t ctime;
+    uint32_t mode;
+    uint64_t dev;
+    uint64_t inode;
+    uint64_t nlink;
+};
+
+/**
+ * Single stat call on the specified path, `errno` is left
+ * set on failure
+ *
+ * @param path file path
+ * @param follow_symlinks whether to report symlink target instead of the link itself
+ * @param out stat to fill
+ * @return false on error
+ */
+bool stat_path(const std::string& path, bool follow_symlinks, file_stat& out);
+
+/**
+ * Single `fstat` call on an open (CRT on Windows) descriptor
+ *
+ * @param fd file descriptor
+ * @param out stat to fill
+ * @return false on error
+ */
+bool stat_handle(int fd, file_stat& out);
+
+#ifndef STATICLIB_WINDOWS
+/**
+ * Single `fstatat` call relative to an open directory
+ *
+ * @param dir_fd directory descriptor
+ * @param name entry name
+ * @param follow_symlinks whether to report symlink target instead of the link itself
+ * @param out stat to fill
+ * @return false on error
+ */
+bool stat_at(int dir_fd, const std::string& name, bool follow_symlinks, file_stat& out);
+#endif // !STATICLIB_WINDOWS
+
+} // namespace
+}
+
+#endif /* WILTON_FS_FILE_STAT_HPP */
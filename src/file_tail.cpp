@@ -0,0 +1,248 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_tail.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "file_tail.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#include "staticlib/support.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "utf8_simd.hpp"
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+const size_t tail_block_size = 64 * 1024;
+// max data consumed by a single follow call
+const size_t follow_read_size = 4 * 1024 * 1024;
+const auto poll_interval = std::chrono::milliseconds(100);
+
+std::string make_line(const char* data, size_t len) {
+    if (len > 0 && '\r' == data[len - 1]) {
+        len -= 1;
+    }
+    auto res = std::string();
+    if (utf8_is_valid(data, len)) {
+        res.assign(data, len);
+    } else {
+        utf8_replace_invalid(data, len, res);
+    }
+    return res;
+}
+
+std::string parent_dir(const std::string& path) {
+#ifdef STATICLIB_WINDOWS
+    auto pos = path.find_last_of("/\\");
+#else // !STATICLIB_WINDOWS
+    auto pos = path.rfind('/');
+#endif // STATICLIB_WINDOWS
+    if (std::string::npos == pos) {
+        return ".";
+    }
+    return 0 == pos ? std::string("/") : path.substr(0, pos);
+}
+
+uint64_t file_inode(const native_file& file) {
+    auto st = file_stat();
+    if (!stat_handle(file.handle(), st)) throw support::exception(TRACEMSG(
+            "Error obtaining file status, path: [" + file.path() + "]"));
+    return st.inode;
+}
+
+} // namespace
+
+tail_result read_tail_lines(const native_file& file, size_t count, bool with_unterminated) {
+    auto size = file.size();
+    auto res = tail_result();
+    res.end_offset = size;
+    if (0 == size || 0 == count) {
+        return res;
+    }
+    // blocks in backward order, together they cover [start, size)
+    auto blocks = std::vector<std::string>();
+    uint64_t start = size;
+    uint64_t line_start = 0;
+    // end of the last complete line
+    uint64_t complete_end = 0;
+    auto break_seen = false;
+    size_t found = 0;
+    while (found < count && start > 0) {
+        auto len = static_cast<size_t>(std::min(start, static_cast<uint64_t>(tail_block_size)));
+        if (size - start + len > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+            throw support::exception(TRACEMSG("Tail is too large to be read into memory," +
+                    " path: [" + file.path() + "]"));
+        }
+        auto block = std::string();
+        block.resize(len);
+        auto read = file.read_at(std::addressof(block.front()), len, start - len);
+        if (read < len) throw support::exception(TRACEMSG(
+                "File was truncated during reading, path: [" + file.path() + "]"));
+        start -= len;
+        for (size_t i = len; i > 0 && found < count; i--) {
+            if ('\n' != block[i - 1]) {
+                continue;
+            }
+            auto pos = start + i - 1;
+            if (!break_seen) {
+                break_seen = true;
+                complete_end = pos + 1;
+                // terminator of the last line is not a separator
+                if (pos + 1 == size || !with_unterminated) {
+                    continue;
+                }
+            }
+            found += 1;
+            if (found == count) {
+                line_start = pos + 1;
+            }
+        }
+        blocks.emplace_back(std::move(block));
+    }
+    auto data = std::string();
+    data.reserve(static_cast<size_t>(size - start));
+    for (auto it = blocks.rbegin(); it != blocks.rend(); ++it) {
+        data.append(*it);
+    }
+    // without line breaks the whole region is a single unterminated line
+    auto end = with_unterminated ? size : complete_end;
+    res.end_offset = std::max(end, line_start);
+    auto pos = static_cast<size_t>(line_start - start);
+    auto end_idx = static_cast<size_t>(res.end_offset - start);
+    while (pos < end_idx) {
+        auto nl = static_cast<const char*>(std::memchr(data.data() + pos, '\n', end_idx - pos));
+        auto line_end = nullptr != nl ? static_cast<size_t>(nl - data.data()) : end_idx;
+        res.lines.emplace_back(make_line(data.data() + pos, line_end - pos));
+        pos = line_end + 1;
+    }
+    return res;
+}
+
+tail_follower::tail_follower(const std::string& path, uint64_t start_offset) :
+file_path(path.data(), path.length()),
+file(new native_file(native_file::open_read(path))),
+inode(file_inode(*file)),
+offset(start_offset) {
+    try {
+        this->watcher = std::unique_ptr<fs_watcher>(new fs_watcher(parent_dir(path), false,
+                watch_modify | watch_create | watch_moved_to));
+    } catch (const std::exception&) {
+        // not supported on this platform or out of watches
+    }
+}
+
+follow_result tail_follower::next(size_t max_lines, std::chrono::milliseconds timeout) {
+    auto res = follow_result();
+    res.rotated = false;
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        take_ready(max_lines, res.lines);
+        if (res.lines.size() >= max_lines) {
+            return res;
+        }
+        auto appended = read_appended(res.rotated);
+        if (!appended && reopen_if_replaced()) {
+            res.rotated = true;
+            continue;
+        }
+        if (appended) {
+            continue;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (!res.lines.empty() || res.rotated || now >= deadline) {
+            return res;
+        }
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+        if (nullptr != watcher) {
+            // any change in the directory wakes up, events themselves are not used
+            watcher->read_events(wait, std::numeric_limits<size_t>::max());
+        } else {
+            std::this_thread::sleep_for(std::min(wait, poll_interval));
+        }
+    }
+}
+
+bool tail_follower::read_appended(bool& rotated) {
+    auto size = file->size();
+    if (size < offset) {
+        // truncated in place (copy-truncate rotation)
+        offset = 0;
+        partial.clear();
+        rotated = true;
+    }
+    if (size == offset) {
+        return false;
+    }
+    auto len = static_cast<size_t>(std::min(size - offset, static_cast<uint64_t>(follow_read_size)));
+    auto prev_len = partial.length();
+    partial.resize(prev_len + len);
+    auto read = file->read_at(std::addressof(partial.front()) + prev_len, len, offset);
+    partial.resize(prev_len + read);
+    offset += read;
+    size_t pos = 0;
+    for (;;) {
+        auto nl = static_cast<const char*>(std::memchr(partial.data() + pos, '\n', partial.length() - pos));
+        if (nullptr == nl) {
+            break;
+        }
+        auto line_end = static_cast<size_t>(nl - partial.data());
+        ready.emplace_back(make_line(partial.data() + pos, line_end - pos));
+        pos = line_end + 1;
+    }
+    partial.erase(0, pos);
+    return read > 0;
+}
+
+bool tail_follower::reopen_if_replaced() {
+    auto st = file_stat();
+    if (!stat_path(file_path, true, st) || st.inode == inode) {
+        // removed and not yet recreated, or still the same file
+        return false;
+    }
+    auto replacement = std::unique_ptr<native_file>(new native_file(native_file::open_read(file_path)));
+    // old file is fully read at this point, its unterminated line is complete
+    if (!partial.empty()) {
+        ready.emplace_back(make_line(partial.data(), partial.length()));
+        partial.clear();
+    }
+    this->inode = file_inode(*replacement);
+    this->file = std::move(replacement);
+    this->offset = 0;
+    return true;
+}
+
+void tail_follower::take_ready(size_t max_lines, std::vector<std::string>& out) {
+    while (!ready.empty() && out.size() < max_lines) {
+        out.emplace_back(std::move(ready.front()));
+        ready.pop_front();
+    }
+}
+
+} // namespace
+}
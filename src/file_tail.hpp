@@ -0,0 +1,115 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   file_tail.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_FILE_TAIL_HPP
+#define WILTON_FS_FILE_TAIL_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "file_stat.hpp"
+#include "fs_watcher.hpp"
+#include "native_file.hpp"
+
+namespace wilton {
+namespace fs {
+
+struct tail_result {
+    // without line terminators, invalid UTF-8 is replaced
+    std::vector<std::string> lines;
+    // position right after the returned data
+    uint64_t end_offset;
+};
+
+/**
+ * Reads last lines scanning backward from EOF in large blocks,
+ * only the blocks containing returned lines are read
+ *
+ * @param file file to read
+ * @param count max number of lines
+ * @param with_unterminated whether to return the last line if it has no line break yet
+ * @return lines in file order
+ */
+tail_result read_tail_lines(const native_file& file, size_t count, bool with_unterminated);
+
+struct follow_result {
+    std::vector<std::string> lines;
+    // file was replaced or truncated since the previous call
+    bool rotated;
+};
+
+/**
+ * Returns lines appended to a file, lines are returned only when their
+ * line breaks are written; rotation by rename or copy-truncate is
+ * detected and the new file is followed from its start; waits for
+ * changes using inotify on the parent directory on Linux and
+ * polling otherwise
+ */
+class tail_follower {
+    std::string file_path;
+    std::unique_ptr<native_file> file;
+    uint64_t inode;
+    uint64_t offset;
+    // unterminated line data
+    std::string partial;
+    std::deque<std::string> ready;
+    std::unique_ptr<fs_watcher> watcher;
+
+public:
+    /**
+     * Starts following
+     *
+     * @param path file path
+     * @param start_offset position to follow from, usually end of the initial tail
+     */
+    tail_follower(const std::string& path, uint64_t start_offset);
+
+    tail_follower(const tail_follower&) = delete;
+
+    tail_follower& operator=(const tail_follower&) = delete;
+
+    /**
+     * Returns appended lines waiting for them if necessary
+     *
+     * @param max_lines max number of lines to return
+     * @param timeout max wait time, zero to return immediately
+     * @return lines, empty on timeout
+     */
+    follow_result next(size_t max_lines, std::chrono::milliseconds timeout);
+
+private:
+    bool read_appended(bool& rotated);
+
+    bool reopen_if_replaced();
+
+    void take_ready(size_t max_lines, std::vector<std::string>& out);
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_FILE_TAIL_HPP */
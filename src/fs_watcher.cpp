@@ -0,0 +1,372 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   fs_watcher.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "fs_watcher.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#ifdef STATICLIB_LINUX
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif // STATICLIB_LINUX
+
+#include "wilton/support/exception.hpp"
+
+#include "dir_reader.hpp"
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+const uint32_t all_events = watch_create | watch_modify | watch_delete |
+        watch_moved_from | watch_moved_to | watch_attrib;
+
+std::string join_path(const std::string& dir, const std::string& name) {
+    if (dir.empty()) return name;
+    if (name.empty()) return dir;
+    return dir + "/" + name;
+}
+
+#ifdef STATICLIB_LINUX
+// 16KB each, limits the work done by a single read_events call
+const size_t max_drain_reads = 64;
+
+uint32_t to_kernel_mask(uint32_t events, bool recursive) {
+    uint32_t res = IN_DELETE_SELF | IN_MOVE_SELF;
+    if (0 != (events & watch_create)) res |= IN_CREATE;
+    if (0 != (events & watch_modify)) res |= IN_MODIFY;
+    if (0 != (events & watch_delete)) res |= IN_DELETE;
+    if (0 != (events & watch_moved_from)) res |= IN_MOVED_FROM;
+    if (0 != (events & watch_moved_to)) res |= IN_MOVED_TO;
+    if (0 != (events & watch_attrib)) res |= IN_ATTRIB;
+    if (recursive) {
+        // needed to track subdirectories
+        res |= IN_CREATE | IN_MOVED_FROM | IN_MOVED_TO;
+    }
+    return res;
+}
+#endif // STATICLIB_LINUX
+
+} // namespace
+
+uint32_t parse_watch_event(const std::string& name) {
+    if ("create" == name) {
+        return watch_create;
+    } else if ("modify" == name) {
+        return watch_modify;
+    } else if ("delete" == name) {
+        return watch_delete;
+    } else if ("movedFrom" == name) {
+        return watch_moved_from;
+    } else if ("movedTo" == name) {
+        return watch_moved_to;
+    } else if ("attrib" == name) {
+        return watch_attrib;
+    }
+    throw support::exception(TRACEMSG("Invalid event specified: [" + name + "]," +
+            " supported events: [create, modify, delete, movedFrom, movedTo, attrib]"));
+}
+
+std::vector<std::string> watch_event_names(uint32_t flags) {
+    auto res = std::vector<std::string>();
+    if (0 != (flags & watch_create)) res.emplace_back("create");
+    if (0 != (flags & watch_modify)) res.emplace_back("modify");
+    if (0 != (flags & watch_delete)) res.emplace_back("delete");
+    if (0 != (flags & watch_moved_from)) res.emplace_back("movedFrom");
+    if (0 != (flags & watch_moved_to)) res.emplace_back("movedTo");
+    if (0 != (flags & watch_attrib)) res.emplace_back("attrib");
+    if (0 != (flags & watch_overflow)) res.emplace_back("overflow");
+    return res;
+}
+
+#ifdef STATICLIB_LINUX
+
+fs_watcher::fs_watcher(const std::string& path, bool recursive, uint32_t events) :
+root(path.data(), path.length()),
+recursive(recursive),
+report_mask(0 != events ? events : all_events),
+kernel_mask(to_kernel_mask(report_mask, recursive)),
+fd(::inotify_init1(IN_CLOEXEC | IN_NONBLOCK)) {
+    if (-1 == fd) throw support::exception(TRACEMSG(
+            "Error initializing inotify, path: [" + path + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    try {
+        add_tree("", false);
+    } catch (...) {
+        ::close(fd);
+        throw;
+    }
+}
+
+fs_watcher::~fs_watcher() {
+    // closing descriptor removes all watches
+    ::close(fd);
+}
+
+std::vector<watch_event> fs_watcher::read_events(std::chrono::milliseconds timeout, size_t max_count) {
+    drain(max_count);
+    if (pending.empty() && timeout.count() > 0) {
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        auto millis = std::min(timeout.count(),
+                static_cast<std::chrono::milliseconds::rep>(std::numeric_limits<int>::max()));
+        auto res = ::poll(std::addressof(pfd), 1, static_cast<int>(millis));
+        if (-1 == res && EINTR != errno) throw support::exception(TRACEMSG(
+                "Error waiting for events, path: [" + root + "]," +
+                " error: [" + ::strerror(errno) + "]"));
+        if (res > 0) {
+            drain(max_count);
+        }
+    }
+    auto count = std::min(max_count, pending.size());
+    auto res = std::vector<watch_event>();
+    res.reserve(count);
+    std::move(pending.begin(), pending.begin() + count, std::back_inserter(res));
+    pending.erase(pending.begin(), pending.begin() + count);
+    pending_index.clear();
+    for (size_t i = 0; i < pending.size(); i++) {
+        pending_index[pending[i].path] = i;
+    }
+    return res;
+}
+
+void fs_watcher::add_tree(const std::string& rel, bool report_contents) {
+    auto stack = std::vector<std::string>();
+    stack.push_back(rel);
+    while (!stack.empty()) {
+        auto dir = std::move(stack.back());
+        stack.pop_back();
+        auto full = join_path(root, dir);
+        auto wd = ::inotify_add_watch(fd, full.c_str(), kernel_mask | IN_ONLYDIR);
+        if (-1 == wd) {
+            if (dir.empty()) throw support::exception(TRACEMSG(
+                    "Error watching directory, path: [" + full + "]," +
+                    " error: [" + ::strerror(errno) + "]" +
+                    (ENOSPC == errno ? ", check 'fs.inotify.max_user_watches' limit" : "")));
+            // changes in this subtree will be missed
+            push_event(dir, watch_overflow, true);
+            continue;
+        }
+        auto existing = dirs.find(wd);
+        if (dirs.end() != existing) {
+            // same inode watched under its old path
+            dir_watches.erase(existing->second);
+        }
+        dirs[wd] = dir;
+        dir_watches[dir] = wd;
+        if (!recursive && !report_contents) {
+            continue;
+        }
+        try {
+            dir_reader reader(full);
+            auto de = dir_entry();
+            while (reader.next(de)) {
+                auto child = join_path(dir, de.name);
+                auto is_dir = entry_type::directory == de.type;
+                if (report_contents) {
+                    // entries created before the watch was added
+                    push_event(child, watch_create, is_dir);
+                }
+                if (is_dir && recursive) {
+                    stack.emplace_back(std::move(child));
+                }
+            }
+        } catch (const std::exception&) {
+            // removed concurrently, deletion is reported by parent
+        }
+    }
+}
+
+void fs_watcher::remove_tree(const std::string& rel) {
+    auto prefix = rel + "/";
+    for (auto it = dir_watches.begin(); it != dir_watches.end();) {
+        auto& path = it->first;
+        if (path == rel || 0 == path.compare(0, prefix.length(), prefix)) {
+            ::inotify_rm_watch(fd, it->second);
+            dirs.erase(it->second);
+            it = dir_watches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void fs_watcher::rename_tree(const std::string& from, const std::string& to) {
+    // watches follow moved inodes, only paths need to be updated
+    auto prefix = from + "/";
+    auto moved = std::vector<std::pair<std::string, int>>();
+    for (auto it = dir_watches.begin(); it != dir_watches.end();) {
+        auto& path = it->first;
+        if (path == from || 0 == path.compare(0, prefix.length(), prefix)) {
+            moved.emplace_back(to + path.substr(from.length()), it->second);
+            it = dir_watches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto& pa : moved) {
+        dirs[pa.second] = pa.first;
+        dir_watches[pa.first] = pa.second;
+    }
+}
+
+// events that are not read are left in the kernel queue for the next call,
+// so a busy directory cannot keep the caller reading forever
+bool fs_watcher::drain(size_t max_events) {
+    alignas(struct inotify_event) char buf[16384];
+    auto received = false;
+    // directories moved out, not yet matched with the moved in part
+    auto moves = std::unordered_map<uint32_t, std::string>();
+    for (size_t reads = 0; reads < max_drain_reads && pending.size() < max_events; reads++) {
+        auto len = ::read(fd, buf, sizeof(buf));
+        if (-1 == len && EINTR == errno) {
+            continue;
+        }
+        if (len <= 0) {
+            break;
+        }
+        received = true;
+        for (char* ptr = buf; ptr < buf + len;) {
+            auto ev = reinterpret_cast<struct inotify_event*>(ptr);
+            ptr += sizeof(struct inotify_event) + ev->len;
+            if (0 != (ev->mask & IN_Q_OVERFLOW)) {
+                push_event("", watch_overflow, true);
+                continue;
+            }
+            auto it = dirs.find(ev->wd);
+            if (dirs.end() == it) {
+                continue;
+            }
+            auto dir = it->second;
+            if (0 != (ev->mask & IN_IGNORED)) {
+                // path may be already taken by a directory moved over this one
+                auto dwit = dir_watches.find(dir);
+                if (dir_watches.end() != dwit && ev->wd == dwit->second) {
+                    dir_watches.erase(dwit);
+                }
+                dirs.erase(it);
+                continue;
+            }
+            auto name = ev->len > 0 ? std::string(ev->name) : std::string();
+            auto path = join_path(dir, name);
+            auto is_dir = 0 != (ev->mask & IN_ISDIR);
+            if (0 != (ev->mask & IN_CREATE)) {
+                push_event(path, watch_create, is_dir);
+                if (is_dir && recursive) {
+                    add_tree(path, true);
+                }
+            }
+            if (0 != (ev->mask & IN_MODIFY)) {
+                push_event(path, watch_modify, is_dir);
+            }
+            if (0 != (ev->mask & IN_ATTRIB)) {
+                push_event(path, watch_attrib, is_dir);
+            }
+            if (0 != (ev->mask & IN_DELETE)) {
+                push_event(path, watch_delete, is_dir);
+            }
+            if (0 != (ev->mask & IN_MOVED_FROM)) {
+                push_event(path, watch_moved_from, is_dir);
+                if (is_dir && recursive) {
+                    moves[ev->cookie] = path;
+                }
+            }
+            if (0 != (ev->mask & IN_MOVED_TO)) {
+                push_event(path, watch_moved_to, is_dir);
+                auto mit = moves.find(ev->cookie);
+                if (is_dir && recursive && moves.end() != mit) {
+                    rename_tree(mit->second, path);
+                    moves.erase(mit);
+                } else if (is_dir && recursive) {
+                    add_tree(path, true);
+                }
+            }
+            // subdirectories removal and moves are reported by their parents
+            if (dir.empty() && 0 != (ev->mask & IN_DELETE_SELF)) {
+                push_event("", watch_delete, true);
+            }
+            if (dir.empty() && 0 != (ev->mask & IN_MOVE_SELF)) {
+                push_event("", watch_moved_from, true);
+            }
+        }
+    }
+    for (auto& en : moves) {
+        remove_tree(en.second);
+    }
+    return received;
+}
+
+#else // !STATICLIB_LINUX
+
+fs_watcher::fs_watcher(const std::string& path, bool recursive, uint32_t events) :
+root(path.data(), path.length()),
+recursive(recursive),
+report_mask(events),
+kernel_mask(0),
+fd(-1) {
+    throw support::exception(TRACEMSG(
+            "Watching file system changes is not supported on this platform, path: [" + path + "]"));
+}
+
+fs_watcher::~fs_watcher() { }
+
+std::vector<watch_event> fs_watcher::read_events(std::chrono::milliseconds, size_t) {
+    return std::vector<watch_event>();
+}
+
+void fs_watcher::add_tree(const std::string&, bool) { }
+
+void fs_watcher::remove_tree(const std::string&) { }
+
+void fs_watcher::rename_tree(const std::string&, const std::string&) { }
+
+bool fs_watcher::drain(size_t) {
+    return false;
+}
+
+#endif // STATICLIB_LINUX
+
+void fs_watcher::push_event(const std::string& path, uint32_t flags, bool directory) {
+    flags &= (report_mask | watch_overflow);
+    if (0 == flags) {
+        return;
+    }
+    auto it = pending_index.find(path);
+    if (pending_index.end() != it) {
+        auto& ev = pending[it->second];
+        ev.flags |= flags;
+        ev.directory = ev.directory || directory;
+        return;
+    }
+    pending_index.emplace(path, pending.size());
+    pending.push_back({path, flags, directory});
+}
+
+} // namespace
+}
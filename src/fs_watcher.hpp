@@ -0,0 +1,135 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   fs_watcher.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_FS_WATCHER_HPP
+#define WILTON_FS_FS_WATCHER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "staticlib/config.hpp"
+
+namespace wilton {
+namespace fs {
+
+enum watch_event_flag : uint32_t {
+    watch_create = 1 << 0,
+    watch_modify = 1 << 1,
+    watch_delete = 1 << 2,
+    watch_moved_from = 1 << 3,
+    watch_moved_to = 1 << 4,
+    watch_attrib = 1 << 5,
+    // events were lost, listed directories must be rescanned
+    watch_overflow = 1 << 6
+};
+
+/**
+ * Parses event name: "create", "modify", "delete", "movedFrom",
+ * "movedTo", "attrib"
+ *
+ * @param name event name
+ * @return event flag
+ */
+uint32_t parse_watch_event(const std::string& name);
+
+/**
+ * Names of all flags set
+ *
+ * @param flags event flags
+ * @return event names
+ */
+std::vector<std::string> watch_event_names(uint32_t flags);
+
+struct watch_event {
+    // relative to the watched root, empty for the root itself
+    std::string path;
+    uint32_t flags;
+    bool directory;
+};
+
+/**
+ * Change notifications for a directory (optionally recursive), based
+ * on inotify; events are accumulated in kernel until read and are
+ * coalesced per path on reading; only supported on Linux
+ */
+class fs_watcher {
+    std::string root;
+    bool recursive;
+    uint32_t report_mask;
+    uint32_t kernel_mask;
+    int fd;
+    // watch descriptor -> relative directory path
+    std::unordered_map<int, std::string> dirs;
+    std::unordered_map<std::string, int> dir_watches;
+    // coalesced events not yet returned, in order of first occurrence
+    std::vector<watch_event> pending;
+    std::unordered_map<std::string, size_t> pending_index;
+
+public:
+    /**
+     * Starts watching
+     *
+     * @param path directory to watch
+     * @param recursive whether to watch all subdirectories, including created later
+     * @param events event flags to report, 0 for all
+     */
+    fs_watcher(const std::string& path, bool recursive, uint32_t events);
+
+    fs_watcher(const fs_watcher&) = delete;
+
+    fs_watcher& operator=(const fs_watcher&) = delete;
+
+    ~fs_watcher();
+
+    size_t watched_dirs_count() const {
+        return dirs.size();
+    }
+
+    /**
+     * Waits for events and returns them coalesced per path
+     *
+     * @param timeout max wait time for the first event, zero to return immediately
+     * @param max_count max number of coalesced events to return
+     * @return events, empty on timeout
+     */
+    std::vector<watch_event> read_events(std::chrono::milliseconds timeout, size_t max_count);
+
+private:
+    void add_tree(const std::string& rel, bool report_contents);
+
+    void remove_tree(const std::string& rel);
+
+    void rename_tree(const std::string& from, const std::string& to);
+
+    bool drain(size_t max_events);
+
+    void push_event(const std::string& path, uint32_t flags, bool directory);
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_FS_WATCHER_HPP */
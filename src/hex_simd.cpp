@@ -0,0 +1,234 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   hex_simd.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "hex_simd.hpp"
+
+#include <cstdint>
+
+#include "cpu_features.hpp"
+
+#ifdef WILTON_FS_X86
+#include <immintrin.h>
+#endif // WILTON_FS_X86
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+const char hex_symbols[] = "0123456789abcdef";
+
+void encode_scalar(const uint8_t* data, size_t len, char* out) {
+    for (size_t i = 0; i < len; i++) {
+        out[i * 2] = hex_symbols[data[i] >> 4];
+        out[i * 2 + 1] = hex_symbols[data[i] & 0x0f];
+    }
+}
+
+// returns 0xff for invalid chars
+uint8_t decode_nibble(uint8_t ch) {
+    if (ch >= '0' && ch <= '9') return static_cast<uint8_t>(ch - '0');
+    auto lower = static_cast<uint8_t>(ch | 0x20);
+    if (lower >= 'a' && lower <= 'f') return static_cast<uint8_t>(lower - 'a' + 10);
+    return 0xff;
+}
+
+bool decode_scalar(const uint8_t* hex, size_t len, uint8_t* out) {
+    for (size_t i = 0; i < len; i += 2) {
+        auto hi = decode_nibble(hex[i]);
+        auto lo = decode_nibble(hex[i + 1]);
+        if (0xff == hi || 0xff == lo) {
+            return false;
+        }
+        out[i / 2] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
+#ifdef WILTON_FS_SSE2
+
+// nibble to char without table lookup: n + '0' + (n > 9 ? 'a' - '0' - 10 : 0)
+__m128i nibbles_to_chars_sse2(__m128i nibbles) {
+    auto gt9 = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    auto chars = _mm_add_epi8(nibbles, _mm_set1_epi8('0'));
+    return _mm_add_epi8(chars, _mm_and_si128(gt9, _mm_set1_epi8('a' - '0' - 10)));
+}
+
+size_t encode_sse2(const uint8_t* data, size_t len, char* out) {
+    auto mask = _mm_set1_epi8(0x0f);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        auto hi = nibbles_to_chars_sse2(_mm_and_si128(_mm_srli_epi16(in, 4), mask));
+        auto lo = nibbles_to_chars_sse2(_mm_and_si128(in, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    return i;
+}
+
+// returns 0 in lanes with invalid chars and sets the mask accordingly
+__m128i chars_to_nibbles_sse2(__m128i chars, int& valid_mask) {
+    auto digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    auto is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    auto alpha = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    auto is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+    valid_mask = _mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha));
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+            _mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+// pairs of nibbles (high first) to bytes, in 16-bit lanes
+__m128i join_nibbles_sse2(__m128i nibbles) {
+    auto hi = _mm_and_si128(_mm_slli_epi16(nibbles, 4), _mm_set1_epi16(0x00f0));
+    auto lo = _mm_srli_epi16(nibbles, 8);
+    return _mm_or_si128(hi, lo);
+}
+
+// returns number of processed input chars, stops at first invalid block
+size_t decode_sse2(const uint8_t* hex, size_t len, uint8_t* out) {
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        int mask0 = 0;
+        int mask1 = 0;
+        auto in0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i));
+        auto in1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i + 16));
+        auto n0 = chars_to_nibbles_sse2(in0, mask0);
+        auto n1 = chars_to_nibbles_sse2(in1, mask1);
+        if (0xffff != mask0 || 0xffff != mask1) {
+            break;
+        }
+        auto bytes = _mm_packus_epi16(join_nibbles_sse2(n0), join_nibbles_sse2(n1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2), bytes);
+    }
+    return i;
+}
+
+#endif // WILTON_FS_SSE2
+
+#ifdef WILTON_FS_X86
+
+WILTON_FS_TARGET("avx2")
+inline __m256i nibbles_to_chars_avx2(__m256i nibbles) {
+    auto gt9 = _mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9));
+    auto chars = _mm256_add_epi8(nibbles, _mm256_set1_epi8('0'));
+    return _mm256_add_epi8(chars, _mm256_and_si256(gt9, _mm256_set1_epi8('a' - '0' - 10)));
+}
+
+WILTON_FS_TARGET("avx2")
+size_t encode_avx2(const uint8_t* data, size_t len, char* out) {
+    auto mask = _mm256_set1_epi8(0x0f);
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        auto in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        auto hi = nibbles_to_chars_avx2(_mm256_and_si256(_mm256_srli_epi16(in, 4), mask));
+        auto lo = nibbles_to_chars_avx2(_mm256_and_si256(in, mask));
+        // unpack works within 128-bit lanes
+        auto first = _mm256_unpacklo_epi8(hi, lo);
+        auto second = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 2),
+                _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 2 + 32),
+                _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    return i;
+}
+
+WILTON_FS_TARGET("avx2")
+inline __m256i chars_to_nibbles_avx2(__m256i chars, int& valid_mask) {
+    auto digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    auto is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    auto alpha = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    auto is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+    valid_mask = _mm256_movemask_epi8(_mm256_or_si256(is_digit, is_alpha));
+    return _mm256_or_si256(_mm256_and_si256(is_digit, digit),
+            _mm256_and_si256(is_alpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+}
+
+WILTON_FS_TARGET("avx2")
+inline __m256i join_nibbles_avx2(__m256i nibbles) {
+    auto hi = _mm256_and_si256(_mm256_slli_epi16(nibbles, 4), _mm256_set1_epi16(0x00f0));
+    auto lo = _mm256_srli_epi16(nibbles, 8);
+    return _mm256_or_si256(hi, lo);
+}
+
+WILTON_FS_TARGET("avx2")
+size_t decode_avx2(const uint8_t* hex, size_t len, uint8_t* out) {
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        int mask0 = 0;
+        int mask1 = 0;
+        auto in0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex + i));
+        auto in1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex + i + 32));
+        auto n0 = chars_to_nibbles_avx2(in0, mask0);
+        auto n1 = chars_to_nibbles_avx2(in1, mask1);
+        if (-1 != mask0 || -1 != mask1) {
+            break;
+        }
+        // pack works within 128-bit lanes, restore order of 64-bit quarters
+        auto packed = _mm256_packus_epi16(join_nibbles_avx2(n0), join_nibbles_avx2(n1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 2),
+                _mm256_permute4x64_epi64(packed, 0xd8));
+    }
+    return i;
+}
+
+#endif // WILTON_FS_X86
+
+} // namespace
+
+void hex_encode(const char* data, size_t len, char* out) {
+    auto udata = reinterpret_cast<const uint8_t*>(data);
+    size_t done = 0;
+#ifdef WILTON_FS_X86
+    if (len >= 32 && cpu_has_avx2()) {
+        done = encode_avx2(udata, len, out);
+    }
+#endif // WILTON_FS_X86
+#ifdef WILTON_FS_SSE2
+    done += encode_sse2(udata + done, len - done, out + done * 2);
+#endif // WILTON_FS_SSE2
+    encode_scalar(udata + done, len - done, out + done * 2);
+}
+
+bool hex_decode(const char* hex, size_t len, char* out) {
+    if (0 != len % 2) {
+        return false;
+    }
+    auto uhex = reinterpret_cast<const uint8_t*>(hex);
+    auto uout = reinterpret_cast<uint8_t*>(out);
+    size_t done = 0;
+#ifdef WILTON_FS_X86
+    if (len >= 64 && cpu_has_avx2()) {
+        done = decode_avx2(uhex, len, uout);
+    }
+#endif // WILTON_FS_X86
+#ifdef WILTON_FS_SSE2
+    done += decode_sse2(uhex + done, len - done, uout + done / 2);
+#endif // WILTON_FS_SSE2
+    // remainder and blocks rejected by vector code
+    return decode_scalar(uhex + done, len - done, uout + done / 2);
+}
+
+} // namespace
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   hex_simd.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_HEX_SIMD_HPP
+#define WILTON_FS_HEX_SIMD_HPP
+
+#include <array>
+#include <cstddef>
+#include <ios>
+#include <string>
+
+namespace wilton {
+namespace fs {
+
+/**
+ * Block hex encoder, SSE2 on x86 with AVX2 runtime dispatch,
+ * produces lowercase output
+ *
+ * @param data input bytes
+ * @param len input length
+ * @param out destination, must have space for `len * 2` chars
+ */
+void hex_encode(const char* data, size_t len, char* out);
+
+/**
+ * Block hex decoder, accepts both lowercase and uppercase digits
+ *
+ * @param hex input chars
+ * @param len input length, must be even
+ * @param out destination, must have space for `len / 2` bytes
+ * @return false if input contains non-hex chars or has odd length
+ */
+bool hex_decode(const char* hex, size_t len, char* out);
+
+/**
+ * Source adapter that encodes the underlying source to hex in blocks,
+ * used in place of `sl::io::hex_sink` copying when reading files
+ */
+template<typename Source>
+class hex_encoding_source {
+    Source& src;
+    std::array<char, 8192> buf;
+
+public:
+    explicit hex_encoding_source(Source& source) :
+    src(source) { }
+
+    hex_encoding_source(const hex_encoding_source&) = delete;
+
+    hex_encoding_source& operator=(const hex_encoding_source&) = delete;
+
+    template<typename Span>
+    std::streamsize read(Span span) {
+        size_t avail = span.size() / 2;
+        if (0 == avail) {
+            return 0;
+        }
+        size_t len = avail < buf.size() ? avail : buf.size();
+        auto read = src.read({buf.data(), len});
+        if (read <= 0) {
+            return read;
+        }
+        hex_encode(buf.data(), static_cast<size_t>(read), span.data());
+        return read * 2;
+    }
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_HEX_SIMD_HPP */
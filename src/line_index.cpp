@@ -0,0 +1,413 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   line_index.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "line_index.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "staticlib/io.hpp"
+#include "staticlib/support.hpp"
+
+#include "wilton/support/exception.hpp"
+
+#include "crc32c_simd.hpp"
+#include "file_contents.hpp"
+#include "search_simd.hpp"
+#include "task_pool.hpp"
+#include "utf8_simd.hpp"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif // _MSC_VER
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+const uint64_t checkpoint_interval = 1024;
+const size_t read_block_size = 1 << 20;
+const uint64_t chunk_size = 32 << 20;
+const char index_magic[8] = {'W', 'F', 'S', 'L', 'I', 'D', 'X', '1'};
+// magic, size, mtime, ctime, inode, lines, lengths length
+const size_t header_size = 8 + 6 * 8;
+
+// newlines found in a chunk, lengths are between line starts inside the chunk
+struct chunk_starts {
+    std::string lengths;
+    uint64_t first;
+    uint64_t last;
+    uint64_t count;
+};
+
+inline uint32_t lowest_bit_index(uint64_t mask) {
+#ifdef _MSC_VER
+    unsigned long idx = 0;
+    auto low = static_cast<uint32_t>(mask);
+    if (0 != low) {
+        _BitScanForward(std::addressof(idx), low);
+        return static_cast<uint32_t>(idx);
+    }
+    _BitScanForward(std::addressof(idx), static_cast<uint32_t>(mask >> 32));
+    return static_cast<uint32_t>(idx) + 32;
+#else // !_MSC_VER
+    return static_cast<uint32_t>(__builtin_ctzll(mask));
+#endif // _MSC_VER
+}
+
+void put_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+// returns false on truncated or overlong input
+bool get_varint(const std::string& in, size_t& pos, uint64_t& value) {
+    value = 0;
+    for (uint32_t shift = 0; shift < 64 && pos < in.length(); shift += 7) {
+        auto byte = static_cast<uint8_t>(in[pos]);
+        pos += 1;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (0 == (byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void put_u64(std::string& out, uint64_t value) {
+    for (size_t i = 0; i < 8; i++) {
+        out.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+}
+
+uint64_t get_u64(const char* data) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; i++) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (i * 8);
+    }
+    return value;
+}
+
+std::string make_line(const char* data, size_t len) {
+    if (len > 0 && '\r' == data[len - 1]) {
+        len -= 1;
+    }
+    auto res = std::string();
+    if (utf8_is_valid(data, len)) {
+        res.assign(data, len);
+    } else {
+        utf8_replace_invalid(data, len, res);
+    }
+    return res;
+}
+
+// line starts are the positions after newlines, except the one at the end of file
+chunk_starts scan_chunk(const native_file& file, uint64_t offset, uint64_t length, uint64_t file_size) {
+    auto res = chunk_starts();
+    res.first = 0;
+    res.last = 0;
+    res.count = 0;
+    auto buf = std::string();
+    buf.resize(static_cast<size_t>(std::min(length, static_cast<uint64_t>(read_block_size))));
+    auto masks = std::vector<uint64_t>((buf.length() + 63) / 64);
+    uint64_t done = 0;
+    while (done < length) {
+        auto len = static_cast<size_t>(std::min(length - done, static_cast<uint64_t>(buf.length())));
+        auto read = file.read_at(std::addressof(buf.front()), len, offset + done);
+        if (read < len) throw support::exception(TRACEMSG(
+                "File was truncated during indexing, path: [" + file.path() + "]"));
+        byte_masks(buf.data(), len, '\n', masks.data());
+        for (size_t i = 0; i < (len + 63) / 64; i++) {
+            auto mask = masks[i];
+            while (0 != mask) {
+                auto start = offset + done + i * 64 + lowest_bit_index(mask) + 1;
+                mask &= mask - 1;
+                if (start == file_size) {
+                    break;
+                }
+                if (0 == res.count) {
+                    res.first = start;
+                } else {
+                    put_varint(res.lengths, start - res.last);
+                }
+                res.last = start;
+                res.count += 1;
+            }
+        }
+        done += len;
+    }
+    return res;
+}
+
+bool same_identity(const file_stat& a, const file_stat& b) {
+    return a.inode == b.inode && a.size == b.size &&
+            a.mtime == b.mtime && a.ctime == b.ctime;
+}
+
+} // namespace
+
+line_index::line_index(const file_stat& identity, uint64_t lines, std::string&& lengths) :
+identity(identity),
+lines(lines),
+lengths(std::move(lengths)) {
+    // lengths are validated here as they may come from a sidecar file
+    uint64_t offset = 0;
+    size_t pos = 0;
+    for (uint64_t i = 0; i < lines; i++) {
+        if (0 == i % checkpoint_interval) {
+            checkpoint_offsets.push_back(offset);
+            checkpoint_positions.push_back(pos);
+        }
+        uint64_t len = 0;
+        if (!get_varint(this->lengths, pos, len) || 0 == len || len > identity.size - offset) {
+            throw support::exception(TRACEMSG("Invalid line index data," +
+                    " line: [" + sl::support::to_string(i) + "]"));
+        }
+        offset += len;
+    }
+    if (offset != identity.size || pos != this->lengths.length()) {
+        throw support::exception(TRACEMSG("Invalid line index data," +
+                " indexed size: [" + sl::support::to_string(offset) + "]," +
+                " file size: [" + sl::support::to_string(identity.size) + "]"));
+    }
+}
+
+line_index line_index::build(const std::string& path, size_t max_workers) {
+    auto file = native_file::open_read(path);
+    auto identity = file_stat();
+    if (!stat_handle(file.handle(), identity)) throw support::exception(TRACEMSG(
+            "Error obtaining file status, path: [" + path + "]"));
+    auto size = identity.size;
+    auto count = static_cast<size_t>((size + chunk_size - 1) / chunk_size);
+    auto chunks = std::vector<chunk_starts>(count);
+    if (count > 1 && max_workers > 1) {
+        shared_task_pool()->parallel_for(count, max_workers, [&](size_t idx) {
+            // descriptors are not shared, positioned reads are emulated on Windows
+            auto chunk_file = native_file::open_read(path);
+            auto offset = idx * chunk_size;
+            chunks[idx] = scan_chunk(chunk_file, offset, std::min(chunk_size, size - offset), size);
+        });
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            auto offset = i * chunk_size;
+            chunks[i] = scan_chunk(file, offset, std::min(chunk_size, size - offset), size);
+        }
+    }
+    // first line starts at 0, last one ends at the end of file
+    auto lengths = std::string();
+    uint64_t lines = size > 0 ? 1 : 0;
+    uint64_t prev = 0;
+    for (auto& ch : chunks) {
+        if (0 == ch.count) {
+            continue;
+        }
+        put_varint(lengths, ch.first - prev);
+        lengths.append(ch.lengths);
+        std::string().swap(ch.lengths);
+        prev = ch.last;
+        lines += ch.count;
+    }
+    if (size > 0) {
+        put_varint(lengths, size - prev);
+    }
+    return line_index(identity, lines, std::move(lengths));
+}
+
+line_index line_index::load(const std::string& index_path) {
+    auto file = native_file::open_read(index_path);
+    auto size = file.size();
+    if (size < header_size + 4 || size > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+        throw support::exception(TRACEMSG("Invalid line index file," +
+                " path: [" + index_path + "], size: [" + sl::support::to_string(size) + "]"));
+    }
+    auto data = std::string();
+    data.resize(static_cast<size_t>(size));
+    auto read = file.read_at(std::addressof(data.front()), data.length(), 0);
+    auto body_len = data.length() - 4;
+    auto crc = static_cast<uint32_t>(get_u64(data.data() + body_len) & 0xffffffff);
+    if (read < data.length() || 0 != std::memcmp(data.data(), index_magic, sizeof(index_magic)) ||
+            crc != crc32c_update(0, data.data(), body_len)) {
+        throw support::exception(TRACEMSG("Invalid line index file, path: [" + index_path + "]"));
+    }
+    auto identity = file_stat();
+    identity.type = entry_type::file;
+    identity.size = get_u64(data.data() + 8);
+    identity.mtime = static_cast<int64_t>(get_u64(data.data() + 16));
+    identity.ctime = static_cast<int64_t>(get_u64(data.data() + 24));
+    identity.inode = get_u64(data.data() + 32);
+    identity.mode = 0;
+    identity.nlink = 0;
+    auto lines = get_u64(data.data() + 40);
+    auto lengths_len = get_u64(data.data() + 48);
+    if (lengths_len != body_len - header_size) {
+        throw support::exception(TRACEMSG("Invalid line index file, path: [" + index_path + "]"));
+    }
+    return line_index(identity, lines, data.substr(header_size, static_cast<size_t>(lengths_len)));
+}
+
+void line_index::save(const std::string& index_path) const {
+    auto data = std::string();
+    data.reserve(header_size + lengths.length() + 4);
+    data.append(index_magic, sizeof(index_magic));
+    put_u64(data, identity.size);
+    put_u64(data, static_cast<uint64_t>(identity.mtime));
+    put_u64(data, static_cast<uint64_t>(identity.ctime));
+    put_u64(data, identity.inode);
+    put_u64(data, lines);
+    put_u64(data, lengths.length());
+    data.append(lengths);
+    auto crc = crc32c_update(0, data.data(), data.length());
+    for (size_t i = 0; i < 4; i++) {
+        data.push_back(static_cast<char>((crc >> (i * 8)) & 0xff));
+    }
+    write_file_contents(index_path, {data.data(), data.length()}, true, false);
+}
+
+size_t line_index::memory_size() const {
+    return lengths.length() + checkpoint_offsets.size() * (sizeof(uint64_t) + sizeof(size_t));
+}
+
+bool line_index::matches(const file_stat& current) const {
+    return entry_type::file == current.type && same_identity(identity, current);
+}
+
+uint64_t line_index::line_offset(uint64_t line) const {
+    if (line >= lines) {
+        return identity.size;
+    }
+    auto cp = static_cast<size_t>(line / checkpoint_interval);
+    auto offset = checkpoint_offsets[cp];
+    auto pos = checkpoint_positions[cp];
+    // validated on construction
+    for (uint64_t i = 0; i < line % checkpoint_interval; i++) {
+        uint64_t len = 0;
+        get_varint(lengths, pos, len);
+        offset += len;
+    }
+    return offset;
+}
+
+std::vector<std::string> read_indexed_lines(const native_file& file, const line_index& index,
+        uint64_t from, uint64_t count) {
+    auto res = std::vector<std::string>();
+    if (from >= index.lines_count() || 0 == count) {
+        return res;
+    }
+    auto to = from + std::min(count, index.lines_count() - from);
+    auto begin = index.line_offset(from);
+    auto end = index.line_offset(to);
+    if (end - begin > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+        throw support::exception(TRACEMSG("Lines range is too large to be read into memory," +
+                " path: [" + file.path() + "]," +
+                " bytes: [" + sl::support::to_string(end - begin) + "]"));
+    }
+    auto data = std::string();
+    data.resize(static_cast<size_t>(end - begin));
+    auto read = data.empty() ? 0 : file.read_at(std::addressof(data.front()), data.length(), begin);
+    if (read < data.length()) throw support::exception(TRACEMSG(
+            "File was truncated after indexing, path: [" + file.path() + "]"));
+    res.reserve(static_cast<size_t>(to - from));
+    size_t pos = 0;
+    while (pos < data.length()) {
+        auto nl = static_cast<const char*>(std::memchr(data.data() + pos, '\n', data.length() - pos));
+        auto line_end = nullptr != nl ? static_cast<size_t>(nl - data.data()) : data.length();
+        res.emplace_back(make_line(data.data() + pos, line_end - pos));
+        pos = line_end + 1;
+    }
+    return res;
+}
+
+line_index_cache::line_index_cache(size_t max_entries) :
+max_entries(max_entries) { }
+
+std::shared_ptr<const line_index> line_index_cache::get(const std::string& path, const file_stat& current) {
+    std::lock_guard<std::mutex> guard{mutex};
+    auto it = entries.find(path);
+    if (entries.end() == it || !it->second->matches(current)) {
+        return std::shared_ptr<const line_index>();
+    }
+    return it->second;
+}
+
+void line_index_cache::put(const std::string& path, std::shared_ptr<const line_index> index) {
+    std::lock_guard<std::mutex> guard{mutex};
+    auto it = entries.find(path);
+    if (entries.end() != it) {
+        it->second = std::move(index);
+        return;
+    }
+    entries.emplace(path, std::move(index));
+    order.push_back(path);
+    while (order.size() > max_entries) {
+        entries.erase(order.front());
+        order.pop_front();
+    }
+}
+
+std::shared_ptr<const line_index> line_index_cache::get_or_build(const std::string& path,
+        const file_stat& current, std::function<std::shared_ptr<const line_index>()> build) {
+    auto promise = std::promise<std::shared_ptr<const line_index>>();
+    auto pending = std::shared_future<std::shared_ptr<const line_index>>();
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        auto it = entries.find(path);
+        if (entries.end() != it && it->second->matches(current)) {
+            return it->second;
+        }
+        auto bit = building.find(path);
+        if (building.end() != bit) {
+            pending = bit->second;
+        } else {
+            building.emplace(path, promise.get_future().share());
+        }
+    }
+    if (pending.valid()) {
+        // build error is rethrown to all waiters
+        return pending.get();
+    }
+    try {
+        auto index = build();
+        put(path, index);
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            building.erase(path);
+        }
+        promise.set_value(index);
+        return index;
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            building.erase(path);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+} // namespace
+}
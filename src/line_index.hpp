@@ -0,0 +1,172 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   line_index.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_LINE_INDEX_HPP
+#define WILTON_FS_LINE_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "staticlib/config.hpp"
+
+#include "file_stat.hpp"
+#include "native_file.hpp"
+
+namespace wilton {
+namespace fs {
+
+/**
+ * Start offsets of all lines of a file, stored as varint-encoded
+ * line lengths (1-2 bytes per line for usual text) with absolute
+ * offsets checkpointed every 1024 lines, so the start of any line
+ * is found by decoding at most 1023 varints; identity of the
+ * indexed file is kept to detect changes
+ */
+class line_index {
+    file_stat identity;
+    uint64_t lines;
+    // lengths of all lines including terminators
+    std::string lengths;
+    // start offset and position in `lengths` of every 1024th line
+    std::vector<uint64_t> checkpoint_offsets;
+    std::vector<size_t> checkpoint_positions;
+
+    line_index(const file_stat& identity, uint64_t lines, std::string&& lengths);
+
+public:
+    /**
+     * Scans the whole file for newlines, big files are split
+     * into chunks scanned in parallel
+     *
+     * @param path file path
+     * @param max_workers parallelism limit
+     * @return index
+     */
+    static line_index build(const std::string& path, size_t max_workers);
+
+    /**
+     * Loads index saved with `save`, contents are checksummed
+     *
+     * @param index_path sidecar file path
+     * @return index
+     */
+    static line_index load(const std::string& index_path);
+
+    /**
+     * Writes index to a sidecar file, atomically replacing
+     * the existing one
+     *
+     * @param index_path sidecar file path
+     */
+    void save(const std::string& index_path) const;
+
+    uint64_t lines_count() const {
+        return lines;
+    }
+
+    uint64_t file_size() const {
+        return identity.size;
+    }
+
+    size_t memory_size() const;
+
+    /**
+     * Checks whether the index was built for the specified file state
+     *
+     * @param current file stat (with symlinks followed)
+     * @return true if file is unchanged
+     */
+    bool matches(const file_stat& current) const;
+
+    /**
+     * Start offset of the specified line
+     *
+     * @param line zero-based line number
+     * @return offset, file size for lines past the end
+     */
+    uint64_t line_offset(uint64_t line) const;
+};
+
+/**
+ * Reads lines using positioned reads of the indexed region only,
+ * CR before LF is trimmed, invalid UTF-8 is replaced
+ *
+ * @param file file opened for reading
+ * @param index index of this file
+ * @param from zero-based number of the first line
+ * @param count max number of lines to read
+ * @return lines
+ */
+std::vector<std::string> read_indexed_lines(const native_file& file, const line_index& index,
+        uint64_t from, uint64_t count);
+
+/**
+ * Indexes of recently used files, entries are validated against
+ * the current file identity on lookup; oldest entries are dropped
+ * when the limit is reached
+ */
+class line_index_cache {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<const line_index>> entries;
+    std::deque<std::string> order;
+    size_t max_entries;
+    // builds in progress, removed when finished
+    std::unordered_map<std::string, std::shared_future<std::shared_ptr<const line_index>>> building;
+
+public:
+    explicit line_index_cache(size_t max_entries);
+
+    line_index_cache(const line_index_cache&) = delete;
+
+    line_index_cache& operator=(const line_index_cache&) = delete;
+
+    std::shared_ptr<const line_index> get(const std::string& path, const file_stat& current);
+
+    void put(const std::string& path, std::shared_ptr<const line_index> index);
+
+    /**
+     * Returns cached index if it matches the file, otherwise obtains it
+     * with the specified function and caches it; concurrent calls for
+     * the same path wait for a single in-flight build and share its result
+     *
+     * @param path indexed file path
+     * @param current current identity of the file
+     * @param build function loading or building the index
+     * @return index
+     */
+    std::shared_ptr<const line_index> get_or_build(const std::string& path, const file_stat& current,
+            std::function<std::shared_ptr<const line_index>()> build);
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_LINE_INDEX_HPP */
@@ -0,0 +1,237 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   native_file.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "native_file.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#ifdef STATICLIB_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif // NOMINMAX
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#include <share.h>
+#include <sys/stat.h>
+#else // !STATICLIB_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif // STATICLIB_WINDOWS
+
+#include "staticlib/support.hpp"
+#include "staticlib/utils.hpp"
+
+#include "wilton/support/exception.hpp"
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+std::string errno_str() {
+    return std::string(::strerror(errno));
+}
+
+uint64_t map_granularity() {
+#ifdef STATICLIB_WINDOWS
+    SYSTEM_INFO si;
+    ::GetSystemInfo(std::addressof(si));
+    return static_cast<uint64_t>(si.dwAllocationGranularity);
+#else // !STATICLIB_WINDOWS
+    static const uint64_t page = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+    return page;
+#endif // STATICLIB_WINDOWS
+}
+
+} // namespace
+
+native_file::native_file(int fd, const std::string& path) :
+fd(fd),
+file_path(path.data(), path.length()) { }
+
+native_file::native_file(native_file&& other) :
+fd(other.fd),
+file_path(std::move(other.file_path)) {
+    other.fd = -1;
+}
+
+native_file::~native_file() {
+    if (-1 != fd) {
+#ifdef STATICLIB_WINDOWS
+        ::_close(fd);
+#else // !STATICLIB_WINDOWS
+        ::close(fd);
+#endif // STATICLIB_WINDOWS
+    }
+}
+
+native_file native_file::open_read(const std::string& path) {
+#ifdef STATICLIB_WINDOWS
+    auto wpath = sl::utils::widen(path);
+    int fd = -1;
+    auto err = ::_wsopen_s(std::addressof(fd), wpath.c_str(),
+            _O_RDONLY | _O_BINARY, _SH_DENYNO, _S_IREAD);
+    if (0 != err) throw support::exception(TRACEMSG(
+            "Error opening file, path: [" + path + "]," +
+            " error: [" + ::strerror(err) + "]"));
+#else // !STATICLIB_WINDOWS
+    int fd = -1;
+    do {
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    } while (-1 == fd && EINTR == errno);
+    if (-1 == fd) throw support::exception(TRACEMSG(
+            "Error opening file, path: [" + path + "]," +
+            " error: [" + errno_str() + "]"));
+#endif // STATICLIB_WINDOWS
+    return native_file(fd, path);
+}
+
+uint64_t native_file::size() const {
+#ifdef STATICLIB_WINDOWS
+    auto res = ::_filelengthi64(fd);
+    if (res < 0) throw support::exception(TRACEMSG(
+            "Error obtaining file size, path: [" + file_path + "]," +
+            " error: [" + errno_str() + "]"));
+    return static_cast<uint64_t>(res);
+#else // !STATICLIB_WINDOWS
+    struct stat st;
+    auto err = ::fstat(fd, std::addressof(st));
+    if (0 != err) throw support::exception(TRACEMSG(
+            "Error obtaining file size, path: [" + file_path + "]," +
+            " error: [" + errno_str() + "]"));
+    return static_cast<uint64_t>(st.st_size);
+#endif // STATICLIB_WINDOWS
+}
+
+size_t native_file::read_at(char* buf, size_t length, uint64_t offset) const {
+    size_t total = 0;
+    while (total < length) {
+        auto chunk = length - total;
+#ifdef STATICLIB_WINDOWS
+        // CRT has no pread, descriptor is not shared between threads
+        if (::_lseeki64(fd, static_cast<__int64>(offset + total), SEEK_SET) < 0) {
+            throw support::exception(TRACEMSG(
+                    "Error seeking file, path: [" + file_path + "]," +
+                    " offset: [" + sl::support::to_string(offset + total) + "]," +
+                    " error: [" + errno_str() + "]"));
+        }
+        auto limit = static_cast<size_t>(std::numeric_limits<int>::max());
+        auto res = ::_read(fd, buf + total, static_cast<unsigned int>(chunk < limit ? chunk : limit));
+#else // !STATICLIB_WINDOWS
+        auto res = ::pread(fd, buf + total, chunk, static_cast<off_t>(offset + total));
+        if (-1 == res && EINTR == errno) {
+            continue;
+        }
+#endif // STATICLIB_WINDOWS
+        if (res < 0) throw support::exception(TRACEMSG(
+                "Error reading file, path: [" + file_path + "]," +
+                " offset: [" + sl::support::to_string(offset + total) + "]," +
+                " error: [" + errno_str() + "]"));
+        if (0 == res) {
+            break;
+        }
+        total += static_cast<size_t>(res);
+    }
+    return total;
+}
+
+mapped_region::mapped_region(const native_file& file, uint64_t offset, size_t length) :
+base(nullptr),
+base_len(0),
+delta(0),
+len(length)
+#ifdef STATICLIB_WINDOWS
+, mapping(nullptr)
+#endif // STATICLIB_WINDOWS
+{
+    if (0 == length) throw support::exception(TRACEMSG(
+            "Cannot map empty region, path: [" + file.path() + "]"));
+    auto gran = map_granularity();
+    auto aligned = offset - (offset % gran);
+    this->delta = static_cast<size_t>(offset - aligned);
+    this->base_len = delta + length;
+#ifdef STATICLIB_WINDOWS
+    auto fh = reinterpret_cast<HANDLE>(::_get_osfhandle(file.handle()));
+    this->mapping = ::CreateFileMappingW(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (nullptr == mapping) throw support::exception(TRACEMSG(
+            "Error creating file mapping, path: [" + file.path() + "]," +
+            " error: [" + sl::support::to_string(::GetLastError()) + "]"));
+    auto ptr = ::MapViewOfFile(mapping, FILE_MAP_READ,
+            static_cast<DWORD>(aligned >> 32), static_cast<DWORD>(aligned & 0xffffffff), base_len);
+    if (nullptr == ptr) {
+        auto code = ::GetLastError();
+        ::CloseHandle(mapping);
+        throw support::exception(TRACEMSG(
+                "Error mapping file, path: [" + file.path() + "]," +
+                " error: [" + sl::support::to_string(code) + "]"));
+    }
+    this->base = static_cast<char*>(ptr);
+#else // !STATICLIB_WINDOWS
+    auto ptr = ::mmap(nullptr, base_len, PROT_READ, MAP_SHARED, file.handle(),
+            static_cast<off_t>(aligned));
+    if (MAP_FAILED == ptr) throw support::exception(TRACEMSG(
+            "Error mapping file, path: [" + file.path() + "]," +
+            " error: [" + errno_str() + "]"));
+    // advisory only, readers scan mappings front to back
+    ::madvise(ptr, base_len, MADV_SEQUENTIAL);
+    this->base = static_cast<char*>(ptr);
+#endif // STATICLIB_WINDOWS
+}
+
+mapped_region::mapped_region(mapped_region&& other) :
+base(other.base),
+base_len(other.base_len),
+delta(other.delta),
+len(other.len)
+#ifdef STATICLIB_WINDOWS
+, mapping(other.mapping)
+#endif // STATICLIB_WINDOWS
+{
+    other.base = nullptr;
+    other.base_len = 0;
+    other.delta = 0;
+    other.len = 0;
+#ifdef STATICLIB_WINDOWS
+    other.mapping = nullptr;
+#endif // STATICLIB_WINDOWS
+}
+
+mapped_region::~mapped_region() {
+    if (nullptr != base) {
+#ifdef STATICLIB_WINDOWS
+        ::UnmapViewOfFile(base);
+        ::CloseHandle(mapping);
+#else // !STATICLIB_WINDOWS
+        ::munmap(base, base_len);
+#endif // STATICLIB_WINDOWS
+    }
+}
+
+} // namespace
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   native_file.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_NATIVE_FILE_HPP
+#define WILTON_FS_NATIVE_FILE_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "staticlib/config.hpp"
+
+namespace wilton {
+namespace fs {
+
+/**
+ * Thin owner of a native (CRT on Windows) file descriptor,
+ * used where `sl::tinydir` file streams do not expose enough
+ * control (positioned reads, memory mapping)
+ */
+class native_file {
+    int fd;
+    std::string file_path;
+
+    native_file(int fd, const std::string& path);
+
+public:
+    static native_file open_read(const std::string& path);
+
+    native_file(const native_file&) = delete;
+
+    native_file& operator=(const native_file&) = delete;
+
+    native_file(native_file&& other);
+
+    native_file& operator=(native_file&&) = delete;
+
+    ~native_file();
+
+    int handle() const {
+        return fd;
+    }
+
+    const std::string& path() const {
+        return file_path;
+    }
+
+    uint64_t size() const;
+
+    /**
+     * Positioned read that does not move the file pointer,
+     * returns less than `length` bytes only on EOF
+     */
+    size_t read_at(char* buf, size_t length, uint64_t offset) const;
+};
+
+/**
+ * Read-only mapping of a file region, unmapped on destruction
+ */
+class mapped_region {
+    char* base;
+    size_t base_len;
+    size_t delta;
+    size_t len;
+#ifdef STATICLIB_WINDOWS
+    void* mapping;
+#endif // STATICLIB_WINDOWS
+
+public:
+    mapped_region(const native_file& file, uint64_t offset, size_t length);
+
+    mapped_region(const mapped_region&) = delete;
+
+    mapped_region& operator=(const mapped_region&) = delete;
+
+    mapped_region(mapped_region&& other);
+
+    mapped_region& operator=(mapped_region&&) = delete;
+
+    ~mapped_region();
+
+    const char* data() const {
+        return base + delta;
+    }
+
+    size_t size() const {
+        return len;
+    }
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_NATIVE_FILE_HPP */
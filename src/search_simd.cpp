@@ -0,0 +1,275 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   search_simd.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "search_simd.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "cpu_features.hpp"
+
+#ifdef WILTON_FS_X86
+#include <immintrin.h>
+#endif // WILTON_FS_X86
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif // _MSC_VER
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+inline uint32_t lowest_bit_index(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long idx = 0;
+    _BitScanForward(std::addressof(idx), mask);
+    return static_cast<uint32_t>(idx);
+#else // !_MSC_VER
+    return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif // _MSC_VER
+}
+
+const char* find_scalar(const char* hay, size_t len, const char* needle, size_t needle_len) {
+    auto end = hay + len - needle_len + 1;
+    auto ptr = hay;
+    while (ptr < end) {
+        auto found = static_cast<const char*>(std::memchr(ptr, needle[0], static_cast<size_t>(end - ptr)));
+        if (nullptr == found) {
+            return nullptr;
+        }
+        if (0 == std::memcmp(found + 1, needle + 1, needle_len - 1)) {
+            return found;
+        }
+        ptr = found + 1;
+    }
+    return nullptr;
+}
+
+// candidate positions are verified without their first and last bytes
+inline bool verify(const char* candidate, const char* needle, size_t needle_len) {
+    return needle_len <= 2 || 0 == std::memcmp(candidate + 1, needle + 1, needle_len - 2);
+}
+
+#ifdef WILTON_FS_SSE2
+
+const char* find_sse2(const char* hay, size_t len, const char* needle, size_t needle_len, size_t& done) {
+    auto first = _mm_set1_epi8(needle[0]);
+    auto last = _mm_set1_epi8(needle[needle_len - 1]);
+    size_t i = 0;
+    for (; i + needle_len - 1 + 16 <= len; i += 16) {
+        auto block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i));
+        auto block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + i + needle_len - 1));
+        auto eq = _mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+        while (0 != mask) {
+            auto candidate = hay + i + lowest_bit_index(mask);
+            if (verify(candidate, needle, needle_len)) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    done = i;
+    return nullptr;
+}
+
+size_t count_sse2(const char* data, size_t len, char byte, size_t& done) {
+    auto target = _mm_set1_epi8(byte);
+    auto zero = _mm_setzero_si128();
+    size_t count = 0;
+    size_t i = 0;
+    while (i + 16 <= len) {
+        // 8-bit counters, flushed before they can overflow
+        auto acc = _mm_setzero_si128();
+        for (size_t j = 0; j < 255 && i + 16 <= len; j++, i += 16) {
+            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(block, target));
+        }
+        auto sums = _mm_sad_epu8(acc, zero);
+        count += static_cast<size_t>(_mm_cvtsi128_si32(sums)) +
+                static_cast<size_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+    }
+    done = i;
+    return count;
+}
+
+size_t masks_sse2(const char* data, size_t len, char byte, uint64_t* masks) {
+    auto target = _mm_set1_epi8(byte);
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        uint64_t mask = 0;
+        for (size_t j = 0; j < 4; j++) {
+            auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + j * 16));
+            auto bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, target)));
+            mask |= static_cast<uint64_t>(bits) << (j * 16);
+        }
+        masks[i / 64] = mask;
+    }
+    return i;
+}
+
+#endif // WILTON_FS_SSE2
+
+#ifdef WILTON_FS_X86
+
+WILTON_FS_TARGET("avx2")
+const char* find_avx2(const char* hay, size_t len, const char* needle, size_t needle_len, size_t& done) {
+    auto first = _mm256_set1_epi8(needle[0]);
+    auto last = _mm256_set1_epi8(needle[needle_len - 1]);
+    size_t i = 0;
+    for (; i + needle_len - 1 + 32 <= len; i += 32) {
+        auto block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i));
+        auto block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + i + needle_len - 1));
+        auto eq = _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        while (0 != mask) {
+            auto candidate = hay + i + lowest_bit_index(mask);
+            if (verify(candidate, needle, needle_len)) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    done = i;
+    return nullptr;
+}
+
+WILTON_FS_TARGET("avx2")
+size_t count_avx2(const char* data, size_t len, char byte, size_t& done) {
+    auto target = _mm256_set1_epi8(byte);
+    auto zero = _mm256_setzero_si256();
+    size_t count = 0;
+    size_t i = 0;
+    while (i + 32 <= len) {
+        auto acc = _mm256_setzero_si256();
+        for (size_t j = 0; j < 255 && i + 32 <= len; j++, i += 32) {
+            auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(block, target));
+        }
+        alignas(32) uint64_t sums[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(sums), _mm256_sad_epu8(acc, zero));
+        count += static_cast<size_t>(sums[0] + sums[1] + sums[2] + sums[3]);
+    }
+    done = i;
+    return count;
+}
+
+WILTON_FS_TARGET("avx2")
+size_t masks_avx2(const char* data, size_t len, char byte, uint64_t* masks) {
+    auto target = _mm256_set1_epi8(byte);
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+        auto bits_lo = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, target)));
+        auto bits_hi = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, target)));
+        masks[i / 64] = static_cast<uint64_t>(bits_lo) | (static_cast<uint64_t>(bits_hi) << 32);
+    }
+    return i;
+}
+
+#endif // WILTON_FS_X86
+
+} // namespace
+
+const char* find_substring(const char* hay, size_t len, const char* needle, size_t needle_len) {
+    if (0 == needle_len) {
+        return hay;
+    }
+    if (needle_len > len) {
+        return nullptr;
+    }
+    if (1 == needle_len) {
+        return static_cast<const char*>(std::memchr(hay, needle[0], len));
+    }
+    size_t done = 0;
+#ifdef WILTON_FS_X86
+    if (cpu_has_avx2()) {
+        auto found = find_avx2(hay, len, needle, needle_len, done);
+        if (nullptr != found) {
+            return found;
+        }
+    }
+#endif // WILTON_FS_X86
+#ifdef WILTON_FS_SSE2
+    if (0 == done) {
+        auto found = find_sse2(hay, len, needle, needle_len, done);
+        if (nullptr != found) {
+            return found;
+        }
+    }
+#endif // WILTON_FS_SSE2
+    // tail shorter than a vector plus the needle
+    return find_scalar(hay + done, len - done, needle, needle_len);
+}
+
+size_t count_byte(const char* data, size_t len, char byte) {
+    size_t count = 0;
+    size_t done = 0;
+#ifdef WILTON_FS_X86
+    if (cpu_has_avx2()) {
+        count = count_avx2(data, len, byte, done);
+    }
+#endif // WILTON_FS_X86
+#ifdef WILTON_FS_SSE2
+    size_t done_sse2 = 0;
+    count += count_sse2(data + done, len - done, byte, done_sse2);
+    done += done_sse2;
+#endif // WILTON_FS_SSE2
+    for (size_t i = done; i < len; i++) {
+        if (byte == data[i]) {
+            count += 1;
+        }
+    }
+    return count;
+}
+
+void byte_masks(const char* data, size_t len, char byte, uint64_t* masks) {
+    size_t done = 0;
+#ifdef WILTON_FS_X86
+    if (cpu_has_avx2()) {
+        done = masks_avx2(data, len, byte, masks);
+    }
+#endif // WILTON_FS_X86
+#ifdef WILTON_FS_SSE2
+    if (0 == done) {
+        done = masks_sse2(data, len, byte, masks);
+    }
+#endif // WILTON_FS_SSE2
+    // whole blocks only above, last partial block is zero-padded
+    for (size_t i = done; i < len; i += 64) {
+        uint64_t mask = 0;
+        for (size_t j = 0; j < 64 && i + j < len; j++) {
+            if (byte == data[i + j]) {
+                mask |= static_cast<uint64_t>(1) << j;
+            }
+        }
+        masks[i / 64] = mask;
+    }
+}
+
+} // namespace
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   search_simd.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_SEARCH_SIMD_HPP
+#define WILTON_FS_SEARCH_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace wilton {
+namespace fs {
+
+/**
+ * Substring search comparing first and last needle bytes over
+ * whole vectors and verifying candidates only, SSE2 on x86 with
+ * AVX2 runtime dispatch
+ *
+ * @param hay data to search in
+ * @param len data length
+ * @param needle substring to find
+ * @param needle_len substring length
+ * @return pointer to the first occurrence, nullptr if not found
+ */
+const char* find_substring(const char* hay, size_t len, const char* needle, size_t needle_len);
+
+/**
+ * Counts occurrences of a byte, used to count lines
+ *
+ * @param data input bytes
+ * @param len input length
+ * @param byte byte to count
+ * @return number of occurrences
+ */
+size_t count_byte(const char* data, size_t len, char byte);
+
+/**
+ * Marks positions of a byte in 64-byte blocks, bit `j` of `masks[i]`
+ * is set when `data[i * 64 + j]` matches; used to find line starts
+ * without a call per line
+ *
+ * @param data input bytes
+ * @param len input length
+ * @param byte byte to find
+ * @param masks output, must have space for `(len + 63) / 64` masks
+ */
+void byte_masks(const char* data, size_t len, char byte, uint64_t* masks);
+
+} // namespace
+}
+
+#endif /* WILTON_FS_SEARCH_SIMD_HPP */
@@ -0,0 +1,235 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   sha256.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "sha256.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "cpu_features.hpp"
+
+#ifdef WILTON_FS_X86
+#include <immintrin.h>
+#endif // WILTON_FS_X86
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+alignas(16) const uint32_t round_constants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+uint32_t rotr(uint32_t val, int bits) {
+    return (val >> bits) | (val << (32 - bits));
+}
+
+uint32_t read_be32(const uint8_t* ptr) {
+    return (static_cast<uint32_t>(ptr[0]) << 24) | (static_cast<uint32_t>(ptr[1]) << 16) |
+            (static_cast<uint32_t>(ptr[2]) << 8) | static_cast<uint32_t>(ptr[3]);
+}
+
+void compress_scalar(uint32_t* state, const uint8_t* data, size_t blocks) {
+    for (size_t b = 0; b < blocks; b++) {
+        auto block = data + b * 64;
+        uint32_t w[64];
+        for (size_t i = 0; i < 16; i++) {
+            w[i] = read_be32(block + i * 4);
+        }
+        for (size_t i = 16; i < 64; i++) {
+            auto s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            auto s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        auto a = state[0];
+        auto b_ = state[1];
+        auto c = state[2];
+        auto d = state[3];
+        auto e = state[4];
+        auto f = state[5];
+        auto g = state[6];
+        auto h = state[7];
+        for (size_t i = 0; i < 64; i++) {
+            auto s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            auto ch = (e & f) ^ (~e & g);
+            auto t1 = h + s1 + ch + round_constants[i] + w[i];
+            auto s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            auto maj = (a & b_) ^ (a & c) ^ (b_ & c);
+            auto t2 = s0 + maj;
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b_;
+            b_ = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b_;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#ifdef WILTON_FS_X86
+
+// each group of 4 rounds also extends the message schedule
+// for the groups that follow, registers are rotated
+WILTON_FS_TARGET("sha,sse4.1,ssse3")
+void compress_sha(uint32_t* state, const uint8_t* data, size_t blocks) {
+    auto mask = _mm_set_epi64x(0x0c0d0e0f08090a0bll, 0x0405060700010203ll);
+    auto tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+    auto state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4));
+    // ABEF and CDGH layout expected by the round instructions
+    tmp = _mm_shuffle_epi32(tmp, 0xb1);
+    state1 = _mm_shuffle_epi32(state1, 0x1b);
+    auto state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+    auto consts = reinterpret_cast<const __m128i*>(round_constants);
+    for (size_t b = 0; b < blocks; b++) {
+        auto input = reinterpret_cast<const __m128i*>(data + b * 64);
+        auto abef_save = state0;
+        auto cdgh_save = state1;
+        __m128i msgs[4];
+        for (size_t i = 0; i < 16; i++) {
+            auto& cur = msgs[i % 4];
+            if (i < 4) {
+                cur = _mm_shuffle_epi8(_mm_loadu_si128(input + i), mask);
+            }
+            auto msg = _mm_add_epi32(cur, _mm_load_si128(consts + i));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            if (i >= 3 && i <= 14) {
+                auto& next = msgs[(i + 1) % 4];
+                next = _mm_add_epi32(next, _mm_alignr_epi8(cur, msgs[(i + 3) % 4], 4));
+                next = _mm_sha256msg2_epu32(next, cur);
+            }
+            msg = _mm_shuffle_epi32(msg, 0x0e);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+            if (i >= 1 && i <= 12) {
+                auto& prev = msgs[(i + 3) % 4];
+                prev = _mm_sha256msg1_epu32(prev, cur);
+            }
+        }
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+    }
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), state1);
+}
+
+#endif // WILTON_FS_X86
+
+void compress(uint32_t* state, const uint8_t* data, size_t blocks) {
+#ifdef WILTON_FS_X86
+    if (cpu_has_sha()) {
+        compress_sha(state, data, blocks);
+        return;
+    }
+#endif // WILTON_FS_X86
+    compress_scalar(state, data, blocks);
+}
+
+} // namespace
+
+sha256_state::sha256_state() :
+buffered(0),
+total(0) {
+    state[0] = 0x6a09e667;
+    state[1] = 0xbb67ae85;
+    state[2] = 0x3c6ef372;
+    state[3] = 0xa54ff53a;
+    state[4] = 0x510e527f;
+    state[5] = 0x9b05688c;
+    state[6] = 0x1f83d9ab;
+    state[7] = 0x5be0cd19;
+    std::memset(buf, 0, sizeof(buf));
+}
+
+void sha256_state::update(const char* data, size_t len) {
+    auto input = reinterpret_cast<const uint8_t*>(data);
+    total += len;
+    if (buffered > 0) {
+        auto fill = std::min(len, sizeof(buf) - buffered);
+        std::memcpy(buf + buffered, input, fill);
+        buffered += fill;
+        input += fill;
+        len -= fill;
+        if (buffered < sizeof(buf)) {
+            return;
+        }
+        compress(state, buf, 1);
+        buffered = 0;
+    }
+    auto blocks = len / sizeof(buf);
+    if (blocks > 0) {
+        compress(state, input, blocks);
+        input += blocks * sizeof(buf);
+        len -= blocks * sizeof(buf);
+    }
+    std::memcpy(buf, input, len);
+    buffered = len;
+}
+
+std::array<uint8_t, 32> sha256_state::digest() const {
+    uint32_t st[8];
+    std::memcpy(st, state, sizeof(st));
+    // padding: 0x80, zeros, bit length in big-endian
+    uint8_t tail[128];
+    std::memset(tail, 0, sizeof(tail));
+    std::memcpy(tail, buf, buffered);
+    tail[buffered] = 0x80;
+    size_t tail_len = buffered + 1 + 8 <= 64 ? 64 : 128;
+    auto bits = total * 8;
+    for (size_t i = 0; i < 8; i++) {
+        tail[tail_len - 1 - i] = static_cast<uint8_t>(bits >> (i * 8));
+    }
+    compress(st, tail, tail_len / 64);
+    auto res = std::array<uint8_t, 32>();
+    for (size_t i = 0; i < 8; i++) {
+        res[i * 4] = static_cast<uint8_t>(st[i] >> 24);
+        res[i * 4 + 1] = static_cast<uint8_t>(st[i] >> 16);
+        res[i * 4 + 2] = static_cast<uint8_t>(st[i] >> 8);
+        res[i * 4 + 3] = static_cast<uint8_t>(st[i]);
+    }
+    return res;
+}
+
+} // namespace
+}
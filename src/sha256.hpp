@@ -0,0 +1,55 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   sha256.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_SHA256_HPP
+#define WILTON_FS_SHA256_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace wilton {
+namespace fs {
+
+/**
+ * Streaming SHA-256, blocks are compressed with SHA extensions
+ * on x86 when available (runtime dispatch)
+ */
+class sha256_state {
+    uint32_t state[8];
+    uint8_t buf[64];
+    size_t buffered;
+    uint64_t total;
+
+public:
+    sha256_state();
+
+    void update(const char* data, size_t len);
+
+    std::array<uint8_t, 32> digest() const;
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_SHA256_HPP */
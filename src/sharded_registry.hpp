@@ -0,0 +1,111 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   sharded_registry.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_SHARDED_REGISTRY_HPP
+#define WILTON_FS_SHARDED_REGISTRY_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace wilton {
+namespace fs {
+
+/**
+ * Handle registry split into independently locked shards, so lookups
+ * of different handles from different threads rarely contend; objects
+ * are shared, so a lookup does not block removal and vice versa
+ */
+template<typename T>
+class sharded_registry {
+    struct shard {
+        std::mutex mutex;
+        std::unordered_map<int64_t, std::shared_ptr<T>> objects;
+    };
+
+    std::array<shard, 16> shards;
+    std::atomic<int64_t> next_handle;
+
+public:
+    sharded_registry() :
+    next_handle(1) { }
+
+    sharded_registry(const sharded_registry&) = delete;
+
+    sharded_registry& operator=(const sharded_registry&) = delete;
+
+    int64_t put(std::shared_ptr<T> obj) {
+        auto handle = next_handle.fetch_add(1);
+        auto& sh = shard_for(handle);
+        std::lock_guard<std::mutex> guard{sh.mutex};
+        sh.objects.emplace(handle, std::move(obj));
+        return handle;
+    }
+
+    /**
+     * Looks up an object
+     *
+     * @param handle object handle
+     * @return object or null if not found
+     */
+    std::shared_ptr<T> get(int64_t handle) {
+        auto& sh = shard_for(handle);
+        std::lock_guard<std::mutex> guard{sh.mutex};
+        auto it = sh.objects.find(handle);
+        if (sh.objects.end() == it) {
+            return std::shared_ptr<T>();
+        }
+        return it->second;
+    }
+
+    /**
+     * Removes an object, it stays alive while other threads use it
+     *
+     * @param handle object handle
+     * @return removed object or null if not found
+     */
+    std::shared_ptr<T> remove(int64_t handle) {
+        auto& sh = shard_for(handle);
+        std::lock_guard<std::mutex> guard{sh.mutex};
+        auto it = sh.objects.find(handle);
+        if (sh.objects.end() == it) {
+            return std::shared_ptr<T>();
+        }
+        auto res = std::move(it->second);
+        sh.objects.erase(it);
+        return res;
+    }
+
+private:
+    shard& shard_for(int64_t handle) {
+        return shards[static_cast<uint64_t>(handle) % shards.size()];
+    }
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_SHARDED_REGISTRY_HPP */
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   task_pool.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "task_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+struct parallel_for_state {
+    std::function<void(size_t)> fun;
+    size_t count;
+    std::atomic<size_t> next;
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t active;
+    bool closed;
+    std::exception_ptr error;
+
+    parallel_for_state(std::function<void(size_t)>&& fun, size_t count) :
+    fun(std::move(fun)),
+    count(count),
+    next(0),
+    active(0),
+    closed(false) { }
+
+    void run() {
+        try {
+            for (;;) {
+                auto idx = next.fetch_add(1);
+                if (idx >= count) break;
+                fun(idx);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> guard{mutex};
+            if (!error) {
+                error = std::current_exception();
+            }
+            // let other participants finish early
+            next.store(count);
+        }
+    }
+};
+
+} // namespace
+
+task_pool::task_pool(size_t threads_count) :
+stopping(false) {
+    for (size_t i = 0; i < threads_count; i++) {
+        workers.emplace_back([this] {
+            worker_loop();
+        });
+    }
+}
+
+task_pool::~task_pool() {
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        stopping = true;
+    }
+    cv.notify_all();
+    for (auto& th : workers) {
+        th.join();
+    }
+}
+
+void task_pool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> guard{mutex};
+        queue.emplace_back(std::move(task));
+    }
+    cv.notify_one();
+}
+
+void task_pool::parallel_for(size_t count, size_t max_workers, std::function<void(size_t)> fun) {
+    if (0 == count) {
+        return;
+    }
+    auto st = std::make_shared<parallel_for_state>(std::move(fun), count);
+    size_t helpers = std::min(std::min(max_workers, workers.size() + 1), count);
+    for (size_t i = 1; i < helpers; i++) {
+        submit([st] {
+            {
+                std::lock_guard<std::mutex> guard{st->mutex};
+                if (st->closed) return;
+                st->active += 1;
+            }
+            st->run();
+            {
+                std::lock_guard<std::mutex> guard{st->mutex};
+                st->active -= 1;
+            }
+            st->cv.notify_all();
+        });
+    }
+    st->run();
+    std::unique_lock<std::mutex> lock{st->mutex};
+    st->closed = true;
+    st->cv.wait(lock, [&st] {
+        return 0 == st->active;
+    });
+    if (st->error) {
+        std::rethrow_exception(st->error);
+    }
+}
+
+void task_pool::worker_loop() {
+    for (;;) {
+        auto task = std::function<void()>();
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            cv.wait(lock, [this] {
+                return stopping || !queue.empty();
+            });
+            if (stopping && queue.empty()) return;
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        try {
+            task();
+        } catch (...) {
+            // tasks report their errors themselves
+        }
+    }
+}
+
+std::shared_ptr<task_pool> shared_task_pool() {
+    static auto pool = std::make_shared<task_pool>(
+            std::max(2u, std::thread::hardware_concurrency()));
+    return pool;
+}
+
+} // namespace
+}
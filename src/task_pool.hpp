@@ -0,0 +1,95 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   task_pool.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_TASK_POOL_HPP
+#define WILTON_FS_TASK_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace wilton {
+namespace fs {
+
+/**
+ * Fixed-size pool of worker threads shared by all parallel fs operations
+ */
+class task_pool {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> queue;
+    std::vector<std::thread> workers;
+    bool stopping;
+
+public:
+    explicit task_pool(size_t threads_count);
+
+    task_pool(const task_pool&) = delete;
+
+    task_pool& operator=(const task_pool&) = delete;
+
+    ~task_pool();
+
+    size_t size() const {
+        return workers.size();
+    }
+
+    /**
+     * Enqueues a task, exceptions thrown from the task are ignored
+     *
+     * @param task task to run on one of the worker threads
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * Runs `fun` for each index in [0, count) using the calling thread
+     * and up to `max_workers - 1` pool threads, returns when all calls
+     * are completed; calling thread never waits for helpers that have
+     * not started yet, so it is safe to call from pool threads
+     *
+     * @param count number of indices
+     * @param max_workers parallelism limit, including the calling thread
+     * @param fun function to call, first exception thrown is rethrown
+     */
+    void parallel_for(size_t count, size_t max_workers, std::function<void(size_t)> fun);
+
+private:
+    void worker_loop();
+};
+
+/**
+ * Module-wide pool, sized to the number of available CPUs
+ *
+ * @return shared pool instance
+ */
+std::shared_ptr<task_pool> shared_task_pool();
+
+} // namespace
+}
+
+#endif /* WILTON_FS_TASK_POOL_HPP */
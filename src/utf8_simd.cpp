@@ -0,0 +1,327 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   utf8_simd.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "utf8_simd.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+#include "cpu_features.hpp"
+
+#ifdef WILTON_FS_X86
+#include <immintrin.h>
+#endif // WILTON_FS_X86
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+// U+FFFD
+const char replacement_marker[] = { '\xef', '\xbf', '\xbd' };
+
+enum class seq_status {
+    ok, not_enough_room, invalid_lead, incomplete_sequence, invalid_sequence
+};
+
+bool is_trail(uint8_t byte) {
+    return 0x80 == (byte & 0xc0);
+}
+
+// same rules as utf8::internal::validate_next
+seq_status validate_next(const uint8_t* it, const uint8_t* end, size_t& length) {
+    uint8_t lead = *it;
+    uint32_t cp = 0;
+    if (lead < 0x80) {
+        length = 1;
+        return seq_status::ok;
+    } else if (0x6 == (lead >> 5)) {
+        length = 2;
+        cp = lead & 0x1f;
+    } else if (0xe == (lead >> 4)) {
+        length = 3;
+        cp = lead & 0x0f;
+    } else if (0x1e == (lead >> 3)) {
+        length = 4;
+        cp = lead & 0x07;
+    } else {
+        length = 1;
+        return seq_status::invalid_lead;
+    }
+    for (size_t i = 1; i < length; i++) {
+        if (it + i == end) return seq_status::not_enough_room;
+        if (!is_trail(it[i])) return seq_status::incomplete_sequence;
+        cp = (cp << 6) | (it[i] & 0x3f);
+    }
+    if (cp > 0x10ffff || (cp >= 0xd800 && cp <= 0xdfff)) {
+        return seq_status::invalid_sequence;
+    }
+    if ((2 == length && cp < 0x80) || (3 == length && cp < 0x800) ||
+            (4 == length && cp < 0x10000)) {
+        return seq_status::invalid_sequence;
+    }
+    return seq_status::ok;
+}
+
+bool is_ascii_block16(const uint8_t* ptr) {
+#ifdef WILTON_FS_SSE2
+    auto vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+    return 0 == _mm_movemask_epi8(vec);
+#else // !WILTON_FS_SSE2
+    uint64_t words[2];
+    std::memcpy(words, ptr, sizeof(words));
+    return 0 == ((words[0] | words[1]) & 0x8080808080808080ULL);
+#endif // WILTON_FS_SSE2
+}
+
+bool is_valid_scalar(const uint8_t* data, size_t len) {
+    const uint8_t* end = data + len;
+    const uint8_t* it = data;
+    while (it < end) {
+        if (end - it >= 16 && is_ascii_block16(it)) {
+            it += 16;
+            continue;
+        }
+        // validate at least one block before trying the fast path again
+        const uint8_t* block_end = (end - it >= 16) ? it + 16 : end;
+        while (it < block_end) {
+            size_t length = 0;
+            if (seq_status::ok != validate_next(it, end, length)) return false;
+            it += length;
+        }
+    }
+    return true;
+}
+
+#ifdef WILTON_FS_X86
+
+// "Validating UTF-8 In Less Than One Instruction Per Byte", Keiser, Lemire, 2021
+
+const uint8_t too_short = 1 << 0;
+const uint8_t too_long = 1 << 1;
+const uint8_t overlong_3 = 1 << 2;
+const uint8_t too_large = 1 << 3;
+const uint8_t surrogate = 1 << 4;
+const uint8_t overlong_2 = 1 << 5;
+const uint8_t too_large_1000 = 1 << 6;
+const uint8_t overlong_4 = 1 << 6;
+const uint8_t two_conts = 1 << 7;
+const uint8_t carry = too_short | too_long | two_conts;
+
+WILTON_FS_TARGET("avx2")
+inline __m256i table_avx2(uint8_t t0, uint8_t t1, uint8_t t2, uint8_t t3,
+        uint8_t t4, uint8_t t5, uint8_t t6, uint8_t t7,
+        uint8_t t8, uint8_t t9, uint8_t t10, uint8_t t11,
+        uint8_t t12, uint8_t t13, uint8_t t14, uint8_t t15) {
+    return _mm256_setr_epi8(
+            static_cast<char>(t0), static_cast<char>(t1), static_cast<char>(t2), static_cast<char>(t3),
+            static_cast<char>(t4), static_cast<char>(t5), static_cast<char>(t6), static_cast<char>(t7),
+            static_cast<char>(t8), static_cast<char>(t9), static_cast<char>(t10), static_cast<char>(t11),
+            static_cast<char>(t12), static_cast<char>(t13), static_cast<char>(t14), static_cast<char>(t15),
+            static_cast<char>(t0), static_cast<char>(t1), static_cast<char>(t2), static_cast<char>(t3),
+            static_cast<char>(t4), static_cast<char>(t5), static_cast<char>(t6), static_cast<char>(t7),
+            static_cast<char>(t8), static_cast<char>(t9), static_cast<char>(t10), static_cast<char>(t11),
+            static_cast<char>(t12), static_cast<char>(t13), static_cast<char>(t14), static_cast<char>(t15));
+}
+
+struct avx2_tables {
+    __m256i byte_1_high;
+    __m256i byte_1_low;
+    __m256i byte_2_high;
+    __m256i low_nibble;
+    __m256i incomplete_max;
+};
+
+WILTON_FS_TARGET("avx2")
+inline __m256i prev_avx2(__m256i input, __m256i prev_input, int n) {
+    auto shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+    switch (n) {
+    case 1: return _mm256_alignr_epi8(input, shifted, 15);
+    case 2: return _mm256_alignr_epi8(input, shifted, 14);
+    default: return _mm256_alignr_epi8(input, shifted, 13);
+    }
+}
+
+WILTON_FS_TARGET("avx2")
+inline __m256i shr4_avx2(__m256i vec, __m256i low_nibble) {
+    return _mm256_and_si256(_mm256_srli_epi16(vec, 4), low_nibble);
+}
+
+WILTON_FS_TARGET("avx2")
+inline __m256i check_block_avx2(const avx2_tables& tb, __m256i input, __m256i prev_input) {
+    auto prev1 = prev_avx2(input, prev_input, 1);
+    auto b1h = _mm256_shuffle_epi8(tb.byte_1_high, shr4_avx2(prev1, tb.low_nibble));
+    auto b1l = _mm256_shuffle_epi8(tb.byte_1_low, _mm256_and_si256(prev1, tb.low_nibble));
+    auto b2h = _mm256_shuffle_epi8(tb.byte_2_high, shr4_avx2(input, tb.low_nibble));
+    auto special = _mm256_and_si256(_mm256_and_si256(b1h, b1l), b2h);
+    auto prev2 = prev_avx2(input, prev_input, 2);
+    auto prev3 = prev_avx2(input, prev_input, 3);
+    // only 111_____ and 1111____ become >= 0x80
+    auto third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xe0 - 0x80)));
+    auto fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+    auto must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(must23, special);
+}
+
+WILTON_FS_TARGET("avx2")
+bool is_valid_avx2(const uint8_t* data, size_t len) {
+    avx2_tables tb;
+    tb.byte_1_high = table_avx2(
+            too_long, too_long, too_long, too_long,
+            too_long, too_long, too_long, too_long,
+            two_conts, two_conts, two_conts, two_conts,
+            too_short | overlong_2,
+            too_short,
+            too_short | overlong_3 | surrogate,
+            too_short | too_large | too_large_1000 | overlong_4);
+    tb.byte_1_low = table_avx2(
+            carry | overlong_3 | overlong_2 | overlong_4,
+            carry | overlong_2,
+            carry,
+            carry,
+            carry | too_large,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000 | surrogate,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000);
+    tb.byte_2_high = table_avx2(
+            too_short, too_short, too_short, too_short,
+            too_short, too_short, too_short, too_short,
+            too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+            too_long | overlong_2 | two_conts | overlong_3 | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_short, too_short, too_short, too_short);
+    tb.low_nibble = _mm256_set1_epi8(0x0f);
+    // lead bytes in the last 3 positions that require more input
+    tb.incomplete_max = _mm256_setr_epi8(
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1), static_cast<char>(0xc0 - 1));
+
+    auto prev_input = _mm256_setzero_si256();
+    auto prev_incomplete = _mm256_setzero_si256();
+    auto error = _mm256_setzero_si256();
+    uint8_t tail[64];
+    size_t i = 0;
+    while (i < len) {
+        const uint8_t* ptr = data + i;
+        if (len - i < 64) {
+            // zero padding is ASCII and does not affect the result
+            std::memset(tail, 0, sizeof(tail));
+            std::memcpy(tail, ptr, len - i);
+            ptr = tail;
+        }
+        auto in0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        auto in1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + 32));
+        if (0 == _mm256_movemask_epi8(_mm256_or_si256(in0, in1))) {
+            error = _mm256_or_si256(error, prev_incomplete);
+        } else {
+            error = _mm256_or_si256(error, check_block_avx2(tb, in0, prev_input));
+            error = _mm256_or_si256(error, check_block_avx2(tb, in1, in0));
+            prev_incomplete = _mm256_subs_epu8(in1, tb.incomplete_max);
+            prev_input = in1;
+        }
+        if (!_mm256_testz_si256(error, error)) {
+            return false;
+        }
+        i += 64;
+    }
+    error = _mm256_or_si256(error, prev_incomplete);
+    return 0 != _mm256_testz_si256(error, error);
+}
+
+#endif // WILTON_FS_X86
+
+} // namespace
+
+bool utf8_is_valid(const char* data, size_t len) {
+    auto udata = reinterpret_cast<const uint8_t*>(data);
+#ifdef WILTON_FS_X86
+    if (len >= 64 && cpu_has_avx2()) {
+        return is_valid_avx2(udata, len);
+    }
+#endif // WILTON_FS_X86
+    return is_valid_scalar(udata, len);
+}
+
+void utf8_replace_invalid(const char* data, size_t len, std::string& out) {
+    auto udata = reinterpret_cast<const uint8_t*>(data);
+    const uint8_t* end = udata + len;
+    const uint8_t* it = udata;
+    const uint8_t* run_start = udata;
+    out.reserve(out.length() + len);
+    while (it < end) {
+        // whole windows of valid input are checked with the fast validator
+        const uint8_t* window_end = end - it > 1024 ? it + 1024 : end;
+        // do not split a sequence between windows
+        for (int i = 0; i < 3 && window_end < end && is_trail(*window_end); i++) {
+            window_end -= 1;
+        }
+        if (utf8_is_valid(reinterpret_cast<const char*>(it), static_cast<size_t>(window_end - it))) {
+            it = window_end;
+            continue;
+        }
+        while (it < window_end) {
+            if (window_end - it >= 16 && is_ascii_block16(it)) {
+                it += 16;
+                continue;
+            }
+            size_t length = 0;
+            auto st = validate_next(it, end, length);
+            if (seq_status::ok == st) {
+                it += length;
+                continue;
+            }
+            // flush valid run and mark the invalid sequence
+            out.append(reinterpret_cast<const char*>(run_start), static_cast<size_t>(it - run_start));
+            out.append(replacement_marker, sizeof(replacement_marker));
+            switch (st) {
+            case seq_status::not_enough_room:
+                it = end;
+                break;
+            case seq_status::invalid_lead:
+                it += 1;
+                break;
+            default:
+                // single marker for the whole sequence
+                it += 1;
+                while (it < end && is_trail(*it)) {
+                    it += 1;
+                }
+            }
+            run_start = it;
+        }
+    }
+    out.append(reinterpret_cast<const char*>(run_start), static_cast<size_t>(end - run_start));
+}
+
+} // namespace
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   utf8_simd.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_UTF8_SIMD_HPP
+#define WILTON_FS_UTF8_SIMD_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace wilton {
+namespace fs {
+
+/**
+ * Drop-in replacement for `utf8::is_valid`, uses AVX2 lookup-based validation
+ * when available, SSE2 ASCII skipping otherwise
+ *
+ * @param data input bytes
+ * @param len input length
+ * @return true if input is valid UTF-8
+ */
+bool utf8_is_valid(const char* data, size_t len);
+
+/**
+ * Drop-in replacement for `utf8::replace_invalid` with `U+FFFD` marker,
+ * valid runs are appended in bulk; truncated sequence at the end
+ * of input is replaced with a marker (utf8cpp 3.x behaviour)
+ *
+ * @param data input bytes
+ * @param len input length
+ * @param out string to append to
+ */
+void utf8_replace_invalid(const char* data, size_t len, std::string& out);
+
+} // namespace
+}
+
+#endif /* WILTON_FS_UTF8_SIMD_HPP */
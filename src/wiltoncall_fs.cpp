@@ -21,12 +21,18 @@
  * Created on May 27, 2017, 12:58 PM
  */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <vector>
 
-#include "utf8.h"
-
 #include "staticlib/io.hpp"
 #include "staticlib/json.hpp"
 #include "staticlib/ranges.hpp"
@@ -34,12 +40,36 @@
 #include "staticlib/utils.hpp"
 #include "staticlib/tinydir.hpp"
 
+#include "wilton/wilton_logging.h"
+
 #include "wilton/support/buffer.hpp"
 #include "wilton/support/exception.hpp"
+#include "wilton/support/handle_registry.hpp"
 #include "wilton/support/logging.hpp"
 #include "wilton/support/registrar.hpp"
 #include "wilton/support/tl_registry.hpp"
 
+#include "async_queue.hpp"
+#include "call_metrics.hpp"
+#include "concurrent_writer.hpp"
+#include "content_cache.hpp"
+#include "dir_tree.hpp"
+#include "dir_walker.hpp"
+#include "fast_copy.hpp"
+#include "file_contents.hpp"
+#include "file_grep.hpp"
+#include "file_hash.hpp"
+#include "file_space.hpp"
+#include "file_stat.hpp"
+#include "file_tail.hpp"
+#include "fs_watcher.hpp"
+#include "hex_simd.hpp"
+#include "line_index.hpp"
+#include "native_file.hpp"
+#include "sharded_registry.hpp"
+#include "task_pool.hpp"
+#include "utf8_simd.hpp"
+
 namespace wilton {
 namespace fs {
 
@@ -47,6 +77,42 @@ namespace { //anonymous
 
 const std::string logger = std::string("wilton.fs");
 
+// level lookup goes through the logging API, its result is cached
+// for a second, so disabled debug logging costs only a clock read
+bool debug_enabled() {
+    static std::atomic<int64_t> checked_at(std::numeric_limits<int64_t>::min() / 2);
+    static std::atomic<bool> enabled(false);
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (now - checked_at.load(std::memory_order_relaxed) < 1000) {
+        return enabled.load(std::memory_order_relaxed);
+    }
+    int res = 0;
+    auto err = wilton_logger_is_level_enabled(logger.c_str(), static_cast<int>(logger.length()),
+            "DEBUG", 5, std::addressof(res));
+    if (nullptr != err) {
+        wilton_free(err);
+        res = 0;
+    }
+    enabled.store(0 != res, std::memory_order_relaxed);
+    checked_at.store(now, std::memory_order_relaxed);
+    return 0 != res;
+}
+
+// initialized from wilton_module_init
+std::shared_ptr<call_metrics> shared_call_metrics() {
+    static auto metrics = std::make_shared<call_metrics>();
+    return metrics;
+}
+
+template<typename Fun>
+support::buffer call_measured(call_metrics& metrics, size_t op_id, Fun fun, sl::io::span<const char> data) {
+    call_metrics::call_scope scope(metrics, op_id);
+    auto res = fun(data);
+    scope.succeeded();
+    return res;
+}
+
 class file_writer {
     sl::io::buffered_sink<sl::tinydir::file_sink> sink;
     bool hex;
@@ -79,12 +145,329 @@ public:
     }
 };
 
+class line_reader {
+    sl::io::buffered_source<sl::tinydir::file_source> src;
+
+public:
+    line_reader(sl::io::buffered_source<sl::tinydir::file_source>&& fsrc) :
+    src(std::move(fsrc)) { }
+
+    line_reader(const line_reader&) = delete;
+
+    line_reader& operator=(const line_reader&) = delete;
+
+    sl::io::buffered_source<sl::tinydir::file_source>& get_source() {
+        return src;
+    }
+};
+
 // initialized from wilton_module_init
 std::shared_ptr<support::tl_registry<file_writer>> local_registry() {
     static auto registry = std::make_shared<support::tl_registry<file_writer>>();
     return registry;
 }
 
+// initialized from wilton_module_init
+std::shared_ptr<sharded_registry<concurrent_writer>> writer_registry() {
+    static auto registry = std::make_shared<sharded_registry<concurrent_writer>>();
+    return registry;
+}
+
+// initialized from wilton_module_init
+std::shared_ptr<support::handle_registry<line_reader>> line_reader_registry() {
+    static auto registry = std::make_shared<support::handle_registry<line_reader>>(
+        [](line_reader* reader) STATICLIB_NOEXCEPT {
+            delete reader;
+        });
+    return registry;
+}
+
+// returns false on EOF, skips lines that are empty after CR removal
+bool read_text_line(sl::io::buffered_source<sl::tinydir::file_source>& src, std::string& out) {
+    for (;;) {
+        auto line = src.read_line();
+        if (line.empty()) return false;
+        if ('\r' == line.back()) {
+            line.pop_back();
+        }
+        if (!line.empty()) { // can be empty only for "^\r\n$" lines
+            if (utf8_is_valid(line.data(), line.length())) {
+                out = std::move(line);
+            } else {
+                out.clear();
+                utf8_replace_invalid(line.data(), line.length(), out);
+            }
+            return true;
+        }
+    }
+}
+
+support::buffer make_hex_array_buffer(const char* data, size_t len) {
+    if (len > static_cast<size_t>(std::numeric_limits<int>::max() / 2)) {
+        throw support::exception(TRACEMSG("Data is too large to be hex-encoded in memory," +
+                " size: [" + sl::support::to_string(len) + "]"));
+    }
+    if (0 == len) {
+        return support::make_string_buffer(sl::utils::empty_string());
+    }
+    auto hex_len = static_cast<int>(len * 2);
+    auto buf = wilton_alloc(hex_len);
+    if (nullptr == buf) throw support::exception(TRACEMSG(
+            "Memory allocation error, size: [" + sl::support::to_string(hex_len) + "]"));
+    hex_encode(data, len, buf);
+    return support::wrap_wilton_buffer(buf, hex_len);
+}
+
+template<typename Sink>
+size_t write_unhexed(sl::io::span<const char> hex, Sink& sink) {
+    if (0 != hex.size() % 2) throw support::exception(TRACEMSG(
+            "Invalid hex data with odd length: [" + sl::support::to_string(hex.size()) + "]"));
+    std::array<char, 8192> buf;
+    size_t written = 0;
+    for (size_t i = 0; i < hex.size(); i += buf.size() * 2) {
+        auto len = std::min(hex.size() - i, buf.size() * 2);
+        if (!hex_decode(hex.data() + i, len, buf.data())) throw support::exception(TRACEMSG(
+                "Invalid hex data, offset: [" + sl::support::to_string(i) + "]"));
+        sl::io::write_all(sink, {buf.data(), len / 2});
+        written += len / 2;
+    }
+    return written;
+}
+
+// decodes whole input, used to keep decoding out of writer locks
+std::string unhex_to_string(sl::io::span<const char> hex) {
+    if (0 != hex.size() % 2) throw support::exception(TRACEMSG(
+            "Invalid hex data with odd length: [" + sl::support::to_string(hex.size()) + "]"));
+    auto res = std::string();
+    res.resize(hex.size() / 2);
+    if (res.length() > 0 && !hex_decode(hex.data(), hex.size(), std::addressof(res.front()))) {
+        throw support::exception(TRACEMSG("Invalid hex data"));
+    }
+    return res;
+}
+
+void check_in_memory_size(const native_file& file, uint64_t size) {
+    if (size > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+        throw support::exception(TRACEMSG("File region is too large to be read into memory," +
+                " path: [" + file.path() + "], size: [" + sl::support::to_string(size) + "]"));
+    }
+}
+
+support::buffer read_mapped_file(const native_file& file, uint64_t offset, uint64_t length, bool hex) {
+    check_in_memory_size(file, length);
+    auto region = mapped_region(file, offset, static_cast<size_t>(length));
+    call_metrics::record_read(region.size());
+    if (!hex) {
+        if (utf8_is_valid(region.data(), region.size())) {
+            return support::make_array_buffer(region.data(), static_cast<int>(region.size()));
+        } else {
+            auto str_utf8 = std::string();
+            str_utf8.reserve(region.size());
+            utf8_replace_invalid(region.data(), region.size(), str_utf8);
+            return support::make_string_buffer(str_utf8);
+        }
+    } else {
+        return make_hex_array_buffer(region.data(), region.size());
+    }
+}
+
+// sequences split by range boundaries are replaced in text mode
+support::buffer read_file_range(const native_file& file, uint64_t offset, uint64_t length, bool hex) {
+    check_in_memory_size(file, length);
+    if (0 == length) {
+        return support::make_string_buffer(sl::utils::empty_string());
+    }
+    auto str = std::string();
+    str.resize(static_cast<size_t>(length));
+    auto read = file.read_at(std::addressof(str.front()), str.length(), offset);
+    str.resize(read);
+    call_metrics::record_read(read);
+    if (!hex) {
+        if (utf8_is_valid(str.data(), str.length())) {
+            return support::make_string_buffer(str);
+        } else {
+            auto str_utf8 = std::string();
+            utf8_replace_invalid(str.data(), str.length(), str_utf8);
+            return support::make_string_buffer(str_utf8);
+        }
+    } else {
+        return make_hex_array_buffer(str.data(), str.length());
+    }
+}
+
+// whole file in read_file output form (validated text or hex), for caching;
+// read until EOF, size is only a hint
+std::string read_file_contents(const native_file& file, uint64_t size, bool hex, uint64_t& read_bytes) {
+    check_in_memory_size(file, hex ? size * 2 : size);
+    auto str = std::string();
+    str.resize(static_cast<size_t>(size));
+    size_t len = 0;
+    for (;;) {
+        if (len == str.length()) {
+            auto probe = '\0';
+            if (0 == file.read_at(std::addressof(probe), 1, len)) {
+                break;
+            }
+            // file grew after stat
+            auto grown = std::max(str.length() * 2, static_cast<size_t>(4096));
+            check_in_memory_size(file, hex ? grown * 2 : grown);
+            str.resize(grown);
+            str[len] = probe;
+            len += 1;
+            continue;
+        }
+        auto read = file.read_at(std::addressof(str[len]), str.length() - len, len);
+        if (0 == read) {
+            break;
+        }
+        len += read;
+    }
+    str.resize(len);
+    read_bytes = len;
+    call_metrics::record_read(len);
+    if (hex) {
+        auto encoded = std::string();
+        encoded.resize(str.length() * 2);
+        if (!str.empty()) {
+            hex_encode(str.data(), str.length(), std::addressof(encoded.front()));
+        }
+        return encoded;
+    }
+    if (utf8_is_valid(str.data(), str.length())) {
+        return str;
+    }
+    auto str_utf8 = std::string();
+    utf8_replace_invalid(str.data(), str.length(), str_utf8);
+    return str_utf8;
+}
+
+// initialized lazily, replaced by fs_configure_cache
+std::mutex& file_cache_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::shared_ptr<content_cache>& file_cache_ref() {
+    static auto cache = std::shared_ptr<content_cache>();
+    return cache;
+}
+
+const size_t default_cache_bytes = 64 * 1024 * 1024;
+
+size_t& file_cache_max_bytes() {
+    static size_t max_bytes = default_cache_bytes;
+    return max_bytes;
+}
+
+// null when cache is disabled
+std::shared_ptr<content_cache> file_cache() {
+    std::lock_guard<std::mutex> guard{file_cache_mutex()};
+    auto& cache = file_cache_ref();
+    if (nullptr == cache.get() && file_cache_max_bytes() > 0) {
+        cache = std::make_shared<content_cache>(file_cache_max_bytes());
+    }
+    return cache;
+}
+
+// sizes of special files (procfs, pipes) are not known in advance
+support::buffer read_file_streaming(const std::string& path, bool hex) {
+    auto src = sl::tinydir::file_source(path);
+    if (!hex) {
+        auto buf = support::make_source_buffer(src);
+        call_metrics::record_read(buf.size());
+        if (utf8_is_valid(buf.data(), buf.size())) {
+            return buf;
+        } else {
+            auto deferred = sl::support::defer([buf]() STATICLIB_NOEXCEPT {
+                wilton_free(buf.data());
+            });
+            auto str_utf8 = std::string();
+            utf8_replace_invalid(buf.data(), buf.size(), str_utf8);
+            return support::make_string_buffer(str_utf8);
+        }
+    } else {
+        hex_encoding_source<sl::tinydir::file_source> hexsrc(src);
+        auto buf = support::make_source_buffer(hexsrc);
+        call_metrics::record_read(buf.size() / 2);
+        return buf;
+    }
+}
+
+support::buffer read_file_cached(const std::string& path, bool hex) {
+    auto cache = file_cache();
+    if (nullptr != cache.get()) {
+        auto cached = cache->get(path, hex);
+        if (nullptr != cached.get()) {
+            return support::make_string_buffer(*cached);
+        }
+    }
+    // special files report zero size, they are streamed and not cached
+    auto st = file_stat();
+    if (nullptr == cache.get() || !stat_path(path, true, st) || entry_type::file != st.type || 0 == st.size) {
+        return read_file_streaming(path, hex);
+    }
+    auto file = native_file::open_read(path);
+    auto identity = file_stat();
+    if (!stat_handle(file.handle(), identity)) throw support::exception(TRACEMSG(
+            "Error accessing file, path: [" + path + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    uint64_t read_bytes = 0;
+    auto content = std::make_shared<const std::string>(read_file_contents(file, identity.size, hex, read_bytes));
+    // file changed while reading, content is returned but not cached
+    if (read_bytes == identity.size) {
+        cache->put(path, hex, identity, content);
+    }
+    return support::make_string_buffer(*content);
+}
+
+// types come from d_type, stats from fstatat relative to the directory
+sl::json::value read_typed_dir(const std::string& path, bool with_stats) {
+    auto vec = std::vector<sl::json::value>();
+    dir_reader reader(path);
+    auto de = dir_entry();
+    auto st = file_stat();
+    while (reader.next(de)) {
+        auto fields = std::vector<sl::json::field>();
+        if (with_stats && reader.stat_entry(de.name, st)) {
+            fields.emplace_back("name", std::move(de.name));
+            fields.emplace_back("type", entry_type_name(st.type));
+            fields.emplace_back("size", static_cast<int64_t>(st.size));
+            fields.emplace_back("mtime", st.mtime);
+        } else {
+            // entry removed concurrently or stats not requested
+            fields.emplace_back("name", std::move(de.name));
+            fields.emplace_back("type", entry_type_name(de.type));
+        }
+        vec.emplace_back(std::move(fields));
+    }
+    return sl::json::value(std::move(vec));
+}
+
+// single lstat, symlink targets are stat'ed additionally
+std::vector<sl::json::field> stat_fields(const std::string& path) {
+    auto st = file_stat();
+    if (!stat_path(path, false, st)) throw support::exception(TRACEMSG(
+            "Error accessing path: [" + path + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    auto is_symlink = entry_type::symlink == st.type;
+    if (is_symlink) {
+        // dangling link is reported as is
+        stat_path(path, true, st);
+    }
+    auto is_file = entry_type::file == st.type;
+    auto fields = std::vector<sl::json::field>();
+    fields.emplace_back("size", is_file ? static_cast<int64_t>(st.size) : 0);
+    fields.emplace_back("isFile", is_file);
+    fields.emplace_back("isDirectory", entry_type::directory == st.type);
+    fields.emplace_back("isSymlink", is_symlink);
+    fields.emplace_back("mtime", st.mtime);
+    fields.emplace_back("ctime", st.ctime);
+    fields.emplace_back("mode", st.mode);
+    fields.emplace_back("inode", static_cast<int64_t>(st.inode));
+    fields.emplace_back("nlink", static_cast<int64_t>(st.nlink));
+    return fields;
+}
+
 } // namespace
 
 support::buffer exists(sl::io::span<const char> data) {
@@ -143,10 +526,16 @@ support::buffer readdir(sl::io::span<const char> data) {
     // json parse
     auto json = sl::json::load(data);
     auto rpath = std::ref(sl::utils::empty_string());
+    auto with_types = false;
+    auto with_stats = false;
     for (const sl::json::field& fi : json.as_object()) {
         auto& name = fi.name();
         if ("path" == name) {
             rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("withTypes" == name) {
+            with_types = fi.as_bool_or_throw(name);
+        } else if ("withStats" == name) {
+            with_stats = fi.as_bool_or_throw(name);
         } else {
             throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
         }
@@ -156,6 +545,9 @@ support::buffer readdir(sl::io::span<const char> data) {
     const std::string& path = rpath.get();
     // call 
     try {
+        if (with_types || with_stats) {
+            return support::make_json_buffer(read_typed_dir(path, with_stats));
+        }
         auto li = sl::tinydir::list_directory(path);
         auto ra = sl::ranges::transform(li, [](const sl::tinydir::path & pa) -> sl::json::value {
             return sl::json::value(pa.filename());
@@ -171,43 +563,155 @@ support::buffer read_file(sl::io::span<const char> data) {
     auto json = sl::json::load(data);
     auto rpath = std::ref(sl::utils::empty_string());
     auto hex = false;
+    auto use_mmap = false;
+    auto cached = false;
+    auto ranged = false;
+    int64_t offset = 0;
+    int64_t length = -1;
     for (const sl::json::field& fi : json.as_object()) {
         auto& name = fi.name();
         if ("path" == name) {
             rpath = fi.as_string_nonempty_or_throw(name);
         } else if ("hex" == name) {
             hex = fi.as_bool_or_throw(name);
+        } else if ("mmap" == name) {
+            use_mmap = fi.as_bool_or_throw(name);
+        } else if ("cache" == name) {
+            cached = fi.as_bool_or_throw(name);
+        } else if ("offset" == name) {
+            offset = fi.as_int64_or_throw(name);
+            ranged = true;
+        } else if ("length" == name) {
+            length = fi.as_int64_or_throw(name);
+            ranged = true;
         } else {
             throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
         }
     }
     if (rpath.get().empty()) throw support::exception(TRACEMSG(
             "Required parameter 'path' not specified"));
+    if (offset < 0) throw support::exception(TRACEMSG(
+            "Invalid 'offset' parameter specified: [" + sl::support::to_string(offset) + "]"));
+    if (ranged && length < -1) throw support::exception(TRACEMSG(
+            "Invalid 'length' parameter specified: [" + sl::support::to_string(length) + "]"));
     const std::string& path = rpath.get();
     // call 
     try {
-        auto src = sl::tinydir::file_source(path);
-        if (!hex) {
-            auto buf = support::make_source_buffer(src);
-            if (utf8::is_valid(buf.begin(), buf.end())) {
-                return buf;
-            } else {
-                auto deferred = sl::support::defer([buf]() STATICLIB_NOEXCEPT {
-                    wilton_free(buf.data());
-                });
-                auto str_utf8 = std::string();
-                utf8::replace_invalid(buf.begin(), buf.end(), std::back_inserter(str_utf8));
-                return support::make_string_buffer(str_utf8);
+        if (cached && !use_mmap && !ranged) {
+            return read_file_cached(path, hex);
+        }
+        if (use_mmap || ranged) {
+            auto file = native_file::open_read(path);
+            auto size = file.size();
+            auto uoffset = static_cast<uint64_t>(offset);
+            auto available = uoffset < size ? size - uoffset : 0;
+            auto ulength = length >= 0 && static_cast<uint64_t>(length) < available ?
+                    static_cast<uint64_t>(length) : available;
+            // empty and special (procfs, pipes) files cannot be mapped,
+            // they are read using streaming logic below
+            if (use_mmap && ulength > 0) {
+                return read_mapped_file(file, uoffset, ulength, hex);
             }
+            if (ranged) {
+                return read_file_range(file, uoffset, ulength, hex);
+            }
+        }
+        return read_file_streaming(path, hex);
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer write_file(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rpath = std::ref(sl::utils::empty_string());
+    auto rdata = std::ref(sl::utils::empty_string());
+    auto hex = false;
+    auto atomic = false;
+    auto sync = false;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("data" == name) {
+            rdata = fi.as_string_or_throw(name);
+        } else if ("hex" == name) {
+            hex = fi.as_bool_or_throw(name);
+        } else if ("atomic" == name) {
+            atomic = fi.as_bool_or_throw(name);
+        } else if ("sync" == name) {
+            sync = fi.as_bool_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    const std::string& path = rpath.get();
+    const std::string& wdata = rdata.get();
+    // call
+    try {
+        if (hex) {
+            auto bytes = unhex_to_string({wdata.data(), wdata.length()});
+            write_file_contents(path, {bytes.data(), bytes.length()}, atomic, sync);
+            call_metrics::record_written(bytes.length());
         } else {
-            auto bufsrc = sl::io::make_buffered_source(src);
-            return support::make_hex_buffer(bufsrc);
+            write_file_contents(path, {wdata.data(), wdata.length()}, atomic, sync);
+            call_metrics::record_written(wdata.length());
         }
+        return support::make_null_buffer();
     } catch (const std::exception& e) {
         throw support::exception(TRACEMSG(e.what()));
     }
 }
 
+support::buffer configure_cache(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t max_bytes = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("maxBytes" == name) {
+            max_bytes = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (max_bytes < 0) throw support::exception(TRACEMSG(
+            "Required parameter 'maxBytes' not specified"));
+    // call, cached entries are dropped, zero size disables cache
+    std::lock_guard<std::mutex> guard{file_cache_mutex()};
+    file_cache_max_bytes() = static_cast<size_t>(max_bytes);
+    file_cache_ref().reset();
+    return support::make_null_buffer();
+}
+
+support::buffer cache_stats(sl::io::span<const char>) {
+    auto cache = file_cache();
+    if (nullptr == cache.get()) {
+        return support::make_json_buffer({
+            { "enabled", false }
+        });
+    }
+    size_t max_bytes = 0;
+    {
+        std::lock_guard<std::mutex> guard{file_cache_mutex()};
+        max_bytes = file_cache_max_bytes();
+    }
+    auto st = cache->stats();
+    return support::make_json_buffer({
+        { "enabled", true },
+        { "maxBytes", static_cast<int64_t>(max_bytes) },
+        { "hits", static_cast<int64_t>(st.hits) },
+        { "misses", static_cast<int64_t>(st.misses) },
+        { "invalidations", static_cast<int64_t>(st.invalidations) },
+        { "evictions", static_cast<int64_t>(st.evictions) },
+        { "entries", static_cast<int64_t>(st.entries) },
+        { "bytes", static_cast<int64_t>(st.bytes) }
+    });
+}
+
 support::buffer read_lines(sl::io::span<const char> data) {
     // json parse
     auto json = sl::json::load(data);
@@ -227,22 +731,88 @@ support::buffer read_lines(sl::io::span<const char> data) {
     try {
         auto vec = std::vector<sl::json::value>();
         auto src = sl::io::make_buffered_source(sl::tinydir::file_source(path));
-        for (;;) {
-            auto line = src.read_line();
-            if (line.empty()) break;
-            if ('\r' == line.back()) {
-                line.pop_back();
-            }
-            if (!line.empty()) { // can be empty only for "^\r\n$" lines
-                if (utf8::is_valid(line.begin(), line.end())) {
-                    vec.emplace_back(std::move(line));
-                } else {
-                    auto line_utf8 = std::string();
-                    utf8::replace_invalid(line.begin(), line.end(), std::back_inserter(line_utf8));
-                    vec.emplace_back(std::move(line_utf8));
-                }
-            }
+        auto line = std::string();
+        uint64_t bytes = 0;
+        while (read_text_line(src, line)) {
+            bytes += line.length();
+            vec.emplace_back(std::move(line));
+        }
+        call_metrics::record_read(bytes);
+        auto res = sl::json::value(std::move(vec));
+        return support::make_json_buffer(res);
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer open_line_reader(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rpath = std::ref(sl::utils::empty_string());
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    const std::string& path = rpath.get();
+    // call
+    try {
+        auto reg = line_reader_registry();
+        auto src = sl::io::make_buffered_source(sl::tinydir::file_source(path));
+        auto reader = new line_reader(std::move(src));
+        auto handle = reg->put(reader);
+        return support::make_json_buffer({
+            { "lineReaderHandle", handle }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer read_lines_batch(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    uint32_t max_lines = 1024;
+    uint32_t max_bytes = std::numeric_limits<uint32_t>::max();
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("lineReaderHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("maxLines" == name) {
+            max_lines = fi.as_uint32_positive_or_throw(name);
+        } else if ("maxBytes" == name) {
+            max_bytes = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
         }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'lineReaderHandle' not specified"));
+    // get handle, reader is used exclusively until returned back
+    auto reg = line_reader_registry();
+    auto reader = reg->remove(handle);
+    if (nullptr == reader) throw support::exception(TRACEMSG(
+            "Invalid 'lineReaderHandle' parameter specified"));
+    auto deferred = sl::support::defer([reg, reader]() STATICLIB_NOEXCEPT {
+        reg->put(reader);
+    });
+    // call, empty array is returned on EOF
+    try {
+        auto vec = std::vector<sl::json::value>();
+        auto line = std::string();
+        size_t bytes = 0;
+        while (vec.size() < max_lines && bytes < max_bytes &&
+                read_text_line(reader->get_source(), line)) {
+            bytes += line.length();
+            vec.emplace_back(std::move(line));
+        }
+        call_metrics::record_read(bytes);
         auto res = sl::json::value(std::move(vec));
         return support::make_json_buffer(res);
     } catch (const std::exception& e) {
@@ -250,6 +820,29 @@ support::buffer read_lines(sl::io::span<const char> data) {
     }
 }
 
+support::buffer close_line_reader(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("lineReaderHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'lineReaderHandle' not specified"));
+    // call
+    auto reg = line_reader_registry();
+    auto reader = reg->remove(handle);
+    if (nullptr == reader) throw support::exception(TRACEMSG(
+            "Invalid 'lineReaderHandle' parameter specified"));
+    delete reader;
+    return support::make_null_buffer();
+}
+
 support::buffer realpath(sl::io::span<const char> data) {
     // json parse
     auto json = sl::json::load(data);
@@ -338,25 +931,149 @@ support::buffer stat(sl::io::span<const char> data) {
     // json parse
     auto json = sl::json::load(data);
     auto rpath = std::ref(sl::utils::empty_string());
+    const std::vector<sl::json::value>* paths = nullptr;
+    auto parallel = false;
     for (const sl::json::field& fi : json.as_object()) {
         auto& name = fi.name();
         if ("path" == name) {
             rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("paths" == name) {
+            paths = std::addressof(fi.as_array_or_throw(name));
+        } else if ("parallel" == name) {
+            parallel = fi.as_bool_or_throw(name);
         } else {
             throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
         }
     }
-    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+    if (rpath.get().empty() && nullptr == paths) throw support::exception(TRACEMSG(
             "Required parameter 'path' not specified"));
     const std::string& path = rpath.get();
     // call
     try {
-        auto tpath = sl::tinydir::path(path);
-        return support::make_json_buffer({
-            { "size", tpath.is_regular_file() ? static_cast<int64_t>(tpath.open_read().size()) : 0 },
-            { "isFile", tpath.is_regular_file() },
-            { "isDirectory", tpath.is_directory() }
-        });
+        if (nullptr == paths) {
+            auto fields = stat_fields(path);
+            // metadata only, file contents are not read
+            call_metrics::record_read(sizeof(file_stat));
+            return support::make_json_buffer(sl::json::value(std::move(fields)));
+        }
+        // bulk mode, errors are reported per path
+        auto results = std::vector<sl::json::value>();
+        results.resize(paths->size());
+        // pool threads are not measured, bytes are recorded by the calling thread
+        std::atomic<uint64_t> bytes(0);
+        auto run = [paths, &results, &bytes](size_t idx) {
+            auto& pa = paths->at(idx).as_string();
+            try {
+                auto fields = stat_fields(pa);
+                bytes.fetch_add(sizeof(file_stat));
+                fields.emplace(fields.begin(), "path", pa);
+                results[idx] = sl::json::value(std::move(fields));
+            } catch (const std::exception& e) {
+                results[idx] = {
+                    { "path", pa },
+                    { "error", std::string(e.what()) }
+                };
+            }
+        };
+        if (parallel && paths->size() > 1) {
+            auto pool = shared_task_pool();
+            pool->parallel_for(paths->size(), pool->size() + 1, run);
+        } else {
+            for (size_t i = 0; i < paths->size(); i++) {
+                run(i);
+            }
+        }
+        call_metrics::record_read(bytes.load());
+        auto res = sl::json::value(std::move(results));
+        return support::make_json_buffer(res);
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer hash(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rpath = std::ref(sl::utils::empty_string());
+    const std::vector<sl::json::value>* paths = nullptr;
+    auto ralgo = std::ref(sl::utils::empty_string());
+    int64_t offset = 0;
+    int64_t length = -1;
+    auto parallel = false;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("paths" == name) {
+            paths = std::addressof(fi.as_array_or_throw(name));
+        } else if ("algo" == name) {
+            ralgo = fi.as_string_nonempty_or_throw(name);
+        } else if ("offset" == name) {
+            offset = fi.as_int64_or_throw(name);
+        } else if ("length" == name) {
+            length = fi.as_int64_or_throw(name);
+        } else if ("parallel" == name) {
+            parallel = fi.as_bool_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (rpath.get().empty() && nullptr == paths) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    if (ralgo.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'algo' not specified"));
+    if (offset < 0) throw support::exception(TRACEMSG(
+            "Invalid 'offset' parameter specified: [" + sl::support::to_string(offset) + "]"));
+    if (length < -1) throw support::exception(TRACEMSG(
+            "Invalid 'length' parameter specified: [" + sl::support::to_string(length) + "]"));
+    const std::string& path = rpath.get();
+    // call, only digests are returned to JS
+    try {
+        auto algo = parse_hash_algo(ralgo.get());
+        auto uoffset = static_cast<uint64_t>(offset);
+        auto ulength = length >= 0 ? static_cast<uint64_t>(length) : std::numeric_limits<uint64_t>::max();
+        auto pool = shared_task_pool();
+        auto workers = pool->size() + 1;
+        if (nullptr == paths) {
+            auto hr = hash_file(path, algo, uoffset, ulength, workers);
+            call_metrics::record_read(hr.size);
+            return support::make_json_buffer({
+                { "digest", std::move(hr.digest) },
+                { "size", hr.size }
+            });
+        }
+        // bulk mode, errors are reported per path
+        auto results = std::vector<sl::json::value>();
+        results.resize(paths->size());
+        // pool threads are not measured, bytes are recorded by the calling thread
+        std::atomic<uint64_t> bytes(0);
+        auto run = [paths, &results, &bytes, algo, uoffset, ulength, workers](size_t idx) {
+            auto& pa = paths->at(idx).as_string();
+            try {
+                auto hr = hash_file(pa, algo, uoffset, ulength, workers);
+                bytes.fetch_add(hr.size);
+                results[idx] = {
+                    { "path", pa },
+                    { "digest", std::move(hr.digest) },
+                    { "size", hr.size }
+                };
+            } catch (const std::exception& e) {
+                results[idx] = {
+                    { "path", pa },
+                    { "error", std::string(e.what()) }
+                };
+            }
+        };
+        if (parallel && paths->size() > 1) {
+            pool->parallel_for(paths->size(), workers, run);
+        } else {
+            for (size_t i = 0; i < paths->size(); i++) {
+                run(i);
+            }
+        }
+        call_metrics::record_read(bytes.load());
+        auto res = sl::json::value(std::move(results));
+        return support::make_json_buffer(res);
     } catch (const std::exception& e) {
         throw support::exception(TRACEMSG(e.what()));
     }
@@ -414,27 +1131,148 @@ support::buffer copy_file(sl::io::span<const char> data) {
     const std::string& newpath = rnewpath.get();
     // call 
     try {
-        auto old = sl::tinydir::path(oldpath);
-        old.copy_file(newpath);
+        auto res = copy_file_fast(oldpath, newpath);
+        call_metrics::record_read(res.bytes);
+        call_metrics::record_written(res.bytes);
         return support::make_null_buffer();
     } catch (const std::exception& e) {
         throw support::exception(TRACEMSG(e.what()));
     }
 }
 
-support::buffer open_tl_file_writer(sl::io::span<const char> data) {
+support::buffer copy_tree(sl::io::span<const char> data) {
     // json parse
     auto json = sl::json::load(data);
-    auto rpath = std::ref(sl::utils::empty_string());
-    auto hex = false;
-    auto append = false;
+    auto roldpath = std::ref(sl::utils::empty_string());
+    auto rnewpath = std::ref(sl::utils::empty_string());
+    uint32_t threads = 0;
     for (const sl::json::field& fi : json.as_object()) {
         auto& name = fi.name();
-        if ("path" == name) {
-            rpath = fi.as_string_nonempty_or_throw(name);
-        } else if ("hex" == name) {
-            hex = fi.as_bool_or_throw(name);
-        } else if ("append" == name) {
+        if ("oldPath" == name) {
+            roldpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("newPath" == name) {
+            rnewpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("threads" == name) {
+            threads = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (roldpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'oldPath' not specified"));
+    if (rnewpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'newPath' not specified"));
+    const std::string& oldpath = roldpath.get();
+    const std::string& newpath = rnewpath.get();
+    // call
+    try {
+        auto workers = 0 != threads ? threads : shared_task_pool()->size() + 1;
+        auto res = copy_directory_tree(oldpath, newpath, workers);
+        call_metrics::record_read(res.bytes);
+        call_metrics::record_written(res.bytes);
+        return support::make_json_buffer({
+            { "directories", static_cast<int64_t>(res.directories) },
+            { "files", static_cast<int64_t>(res.files) },
+            { "symlinks", static_cast<int64_t>(res.symlinks) },
+            { "bytes", static_cast<int64_t>(res.bytes) }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer mkdirs(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rpath = std::ref(sl::utils::empty_string());
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    const std::string& path = rpath.get();
+    // call
+    try {
+        auto created = create_directories(path);
+        return support::make_json_buffer({
+            { "created", static_cast<int64_t>(created) }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+// initialized from wilton_module_init
+std::shared_ptr<trash_purger> shared_trash_purger() {
+    static auto purger = std::make_shared<trash_purger>(
+        [](const std::string& path, const std::string& err) {
+            wilton::support::log_warn(logger, std::string("Background tree removal failed,") +
+                    " path: [" + path + "], error: [" + err + "]");
+        });
+    return purger;
+}
+
+support::buffer rmtree(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rpath = std::ref(sl::utils::empty_string());
+    uint32_t threads = 0;
+    auto background = false;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("threads" == name) {
+            threads = fi.as_uint32_positive_or_throw(name);
+        } else if ("background" == name) {
+            background = fi.as_bool_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    const std::string& path = rpath.get();
+    // call
+    try {
+        if (!background) {
+            auto workers = 0 != threads ? threads : shared_task_pool()->size() + 1;
+            auto res = remove_directory_tree(path, workers);
+            return support::make_json_buffer({
+                { "directories", static_cast<int64_t>(res.directories) },
+                { "files", static_cast<int64_t>(res.files) }
+            });
+        }
+        // original path is free on return, trash is removed on the purger thread,
+        // removal is cancelled on module unload
+        auto trash = move_to_trash(path);
+        shared_trash_purger()->submit(trash);
+        return support::make_json_buffer({
+            { "trashPath", trash }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer open_tl_file_writer(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rpath = std::ref(sl::utils::empty_string());
+    auto hex = false;
+    auto append = false;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("hex" == name) {
+            hex = fi.as_bool_or_throw(name);
+        } else if ("append" == name) {
             append = fi.as_bool_or_throw(name);
         } else {
             throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
@@ -452,8 +1290,10 @@ support::buffer open_tl_file_writer(sl::io::span<const char> data) {
         auto sink = sl::io::make_buffered_sink(std::move(fsink));
         auto writer = file_writer(std::move(sink), hex);
         reg->put(std::move(writer));
-        wilton::support::log_debug(logger, std::string("TL file writer opened,") + 
-                " path: [" + path + "], append: [" + (append ? "true" : "false") + "]");
+        if (debug_enabled()) {
+            wilton::support::log_debug(logger, std::string("TL file writer opened,") +
+                    " path: [" + path + "], append: [" + (append ? "true" : "false") + "]");
+        }
         return support::make_null_buffer();
     } catch (const std::exception& e) {
         throw support::exception(TRACEMSG(e.what()));
@@ -463,18 +1303,20 @@ support::buffer open_tl_file_writer(sl::io::span<const char> data) {
 support::buffer append_tl_file_writer(sl::io::span<const char> data) {
     auto reg = local_registry();
     auto& writer = reg->peek();
-    auto src = sl::io::array_source(data.data(), data.size());
     auto& sink = writer.get_sink();
     size_t written = 0;
     if (writer.is_hex()) {
-        auto unhexer = sl::io::make_hex_source(src);
-        written = sl::io::copy_all(unhexer, sink);
+        written = write_unhexed(data, sink);
     } else {
+        auto src = sl::io::array_source(data.data(), data.size());
         written = sl::io::copy_all(src, sink);
     }
-    wilton::support::log_debug(logger, std::string("TL file writer appended,") + 
-            " path: [" + writer.path() + "]," +
-            " bytes: [" + sl::support::to_string(written) + "]");
+    call_metrics::record_written(written);
+    if (debug_enabled()) {
+        wilton::support::log_debug(logger, std::string("TL file writer appended,") +
+                " path: [" + writer.path() + "]," +
+                " bytes: [" + sl::support::to_string(written) + "]");
+    }
     return support::make_null_buffer();
 }
 
@@ -484,12 +1326,138 @@ support::buffer close_tl_file_writer(sl::io::span<const char>) {
         // will be destroyed at the end of scope
         // no reinsertion logic on unlikely error
         auto writer = reg->remove();
-        wilton::support::log_debug(logger, std::string("TL file writer closed,") +
-                " path: [" + writer.path() + "]");
+        if (debug_enabled()) {
+            wilton::support::log_debug(logger, std::string("TL file writer closed,") +
+                    " path: [" + writer.path() + "]");
+        }
     }
     return support::make_null_buffer();
 }
 
+support::buffer open_writer(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rpath = std::ref(sl::utils::empty_string());
+    auto hex = false;
+    auto append = false;
+    auto opts = writer_options();
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("hex" == name) {
+            hex = fi.as_bool_or_throw(name);
+        } else if ("append" == name) {
+            append = fi.as_bool_or_throw(name);
+        } else if ("bufferSize" == name) {
+            opts.buffer_size = fi.as_uint32_positive_or_throw(name);
+        } else if ("preallocate" == name) {
+            auto len = fi.as_int64_or_throw(name);
+            if (len < 0) throw support::exception(TRACEMSG(
+                    "Invalid negative 'preallocate' parameter specified"));
+            opts.preallocate = static_cast<uint64_t>(len);
+        } else if ("sync" == name) {
+            opts.sync = parse_sync_mode(fi.as_string_nonempty_or_throw(name));
+        } else if ("syncIntervalMillis" == name) {
+            opts.sync_interval_millis = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    const std::string& path = rpath.get();
+    // create writer
+    try {
+        auto reg = writer_registry();
+        auto writer = concurrent_writer::open(path, append, hex, opts);
+        auto handle = reg->put(std::move(writer));
+        if (debug_enabled()) {
+            wilton::support::log_debug(logger, std::string("File writer opened,") +
+                    " path: [" + path + "], append: [" + (append ? "true" : "false") + "]," +
+                    " handle: [" + sl::support::to_string(handle) + "]");
+        }
+        return support::make_json_buffer({
+            { "writerHandle", handle }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer write(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto rdata = std::ref(sl::utils::empty_string());
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("writerHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("data" == name) {
+            rdata = fi.as_string_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'writerHandle' not specified"));
+    const std::string& wdata = rdata.get();
+    // get handle, writer can be used from other threads concurrently
+    auto writer = writer_registry()->get(handle);
+    if (nullptr == writer.get()) throw support::exception(TRACEMSG(
+            "Invalid 'writerHandle' parameter specified"));
+    // call
+    try {
+        size_t written = 0;
+        if (writer->is_hex()) {
+            auto bytes = unhex_to_string({wdata.data(), wdata.length()});
+            written = writer->write({bytes.data(), bytes.length()});
+        } else {
+            written = writer->write({wdata.data(), wdata.length()});
+        }
+        call_metrics::record_written(written);
+        if (debug_enabled()) {
+            wilton::support::log_debug(logger, std::string("File writer appended,") +
+                    " path: [" + writer->path() + "]," +
+                    " bytes: [" + sl::support::to_string(written) + "]");
+        }
+        return support::make_null_buffer();
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer close_writer(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("writerHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'writerHandle' not specified"));
+    // call, writes running concurrently are completed first
+    auto writer = writer_registry()->remove(handle);
+    if (nullptr == writer.get()) throw support::exception(TRACEMSG(
+            "Invalid 'writerHandle' parameter specified"));
+    try {
+        writer->close();
+        if (debug_enabled()) {
+            wilton::support::log_debug(logger, std::string("File writer closed,") +
+                    " path: [" + writer->path() + "]");
+        }
+        return support::make_null_buffer();
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
 support::buffer symlink(sl::io::span<const char> data) {
     // json parse
     auto json = sl::json::load(data);
@@ -525,7 +1493,9 @@ support::buffer insert_file(sl::io::span<const char> data) {
     auto json = sl::json::load(data);
     auto rsource_path = std::ref(sl::utils::empty_string());
     auto rdest_path = std::ref(sl::utils::empty_string());
-    int32_t offset = 0;
+    int64_t offset = 0;
+    int64_t source_offset = 0;
+    int64_t length = -1;
     for (const sl::json::field& fi : json.as_object()) {
         auto& name = fi.name();
         if ("sourcePath" == name) {
@@ -533,7 +1503,11 @@ support::buffer insert_file(sl::io::span<const char> data) {
         } else if ("destPath" == name) {
             rdest_path = fi.as_string_nonempty_or_throw(name);
         } else if ("offset" == name) {
-            offset = fi.as_int32_or_throw(name);
+            offset = fi.as_int64_or_throw(name);
+        } else if ("sourceOffset" == name) {
+            source_offset = fi.as_int64_or_throw(name);
+        } else if ("length" == name) {
+            length = fi.as_int64_or_throw(name);
         } else {
             throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
         }
@@ -542,16 +1516,23 @@ support::buffer insert_file(sl::io::span<const char> data) {
             "Required parameter 'sourcePath' not specified"));
     if (rdest_path.get().empty()) throw support::exception(TRACEMSG(
             "Required parameter 'destPath' not specified"));
+    if (offset < 0) throw support::exception(TRACEMSG(
+            "Invalid 'offset' parameter specified: [" + sl::support::to_string(offset) + "]"));
+    if (source_offset < 0) throw support::exception(TRACEMSG(
+            "Invalid 'sourceOffset' parameter specified: [" + sl::support::to_string(source_offset) + "]"));
+    if (length < -1) throw support::exception(TRACEMSG(
+            "Invalid 'length' parameter specified: [" + sl::support::to_string(length) + "]"));
 
     const std::string& source_path = rsource_path.get();
     const std::string& dest_path = rdest_path.get();
 
-    // call
+    // call, source is copied till EOF without length
     try {
-        auto dp = sl::tinydir::path(dest_path);
-        auto dest = dp.open_write(sl::tinydir::file_sink::open_mode::from_file);
-        dest.seek(offset);
-        dest.write_from_file(source_path);
+        auto ulength = length >= 0 ? static_cast<uint64_t>(length) : std::numeric_limits<uint64_t>::max();
+        auto res = copy_file_region(source_path, static_cast<uint64_t>(source_offset), ulength,
+                dest_path, static_cast<uint64_t>(offset));
+        call_metrics::record_read(res.bytes);
+        call_metrics::record_written(res.bytes);
         return support::make_null_buffer();
     } catch (const std::exception& e) {
         throw support::exception(TRACEMSG(e.what()));
@@ -562,31 +1543,1193 @@ support::buffer resize_file(sl::io::span<const char> data) {
     // json parse
     auto json = sl::json::load(data);
     auto rpath = std::ref(sl::utils::empty_string());
-    size_t new_size = 0;
+    int64_t new_size = 0;
+    auto size_specified = false;
+    auto allocate = false;
+    auto holes = std::vector<file_range>();
+    auto holes_specified = false;
     for (const sl::json::field& fi : json.as_object()) {
         auto& name = fi.name();
         if ("path" == name) {
             rpath = fi.as_string_nonempty_or_throw(name);
         } else if ("size" == name) {
-            new_size = fi.as_int32_or_throw(name);
+            new_size = fi.as_int64_or_throw(name);
+            size_specified = true;
+        } else if ("allocate" == name) {
+            allocate = fi.as_bool_or_throw(name);
+        } else if ("holes" == name) {
+            holes_specified = true;
+            for (auto& ho : fi.as_array_or_throw(name)) {
+                int64_t hoffset = -1;
+                int64_t hlength = -1;
+                for (const sl::json::field& hf : ho.as_object_or_throw(name)) {
+                    if ("offset" == hf.name()) {
+                        hoffset = hf.as_int64_or_throw(name + ".offset");
+                    } else if ("length" == hf.name()) {
+                        hlength = hf.as_int64_or_throw(name + ".length");
+                    } else {
+                        throw support::exception(TRACEMSG("Unknown data field: [" + name + "." + hf.name() + "]"));
+                    }
+                }
+                if (hoffset < 0 || hlength < 0) throw support::exception(TRACEMSG(
+                        "Invalid 'holes' parameter specified, non-negative 'offset' and 'length' are required"));
+                holes.push_back({static_cast<uint64_t>(hoffset), static_cast<uint64_t>(hlength)});
+            }
         } else {
             throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
         }
     }
     if (rpath.get().empty()) throw support::exception(TRACEMSG(
             "Required parameter 'path' not specified"));
+    if (new_size < 0) throw support::exception(TRACEMSG(
+            "Invalid 'size' parameter specified: [" + sl::support::to_string(new_size) + "]"));
     const std::string& path = rpath.get();
-    // call
+    // call, with holes only the size is kept unless specified
     try {
-        auto tpath = sl::tinydir::path(path);
-        tpath.resize(new_size);
-
+        if (size_specified || !holes_specified) {
+            resize_file_space(path, static_cast<uint64_t>(new_size), allocate);
+        }
+        if (!holes.empty()) {
+            punch_file_holes(path, holes);
+        }
         return support::make_null_buffer();
     } catch (const std::exception& e) {
         throw support::exception(TRACEMSG(e.what()));
     }
 }
 
+namespace { // anonymous
+
+struct walk_params {
+    std::string path;
+    walk_options opts;
+    uint32_t threads = 0;
+};
+
+// initialized from wilton_module_init
+std::shared_ptr<support::handle_registry<dir_walk_stream>> walker_registry() {
+    static auto registry = std::make_shared<support::handle_registry<dir_walk_stream>>(
+        [](dir_walk_stream* walker) STATICLIB_NOEXCEPT {
+            delete walker;
+        });
+    return registry;
+}
+
+// returns false for fields that are not walk options
+bool parse_walk_field(const sl::json::field& fi, walk_params& params) {
+    auto& name = fi.name();
+    if ("path" == name) {
+        params.path = fi.as_string_nonempty_or_throw(name);
+    } else if ("maxDepth" == name) {
+        params.opts.max_depth = fi.as_uint32_positive_or_throw(name);
+    } else if ("glob" == name) {
+        params.opts.glob = fi.as_string_nonempty_or_throw(name);
+    } else if ("followSymlinks" == name) {
+        params.opts.follow_symlinks = fi.as_bool_or_throw(name);
+    } else if ("threads" == name) {
+        params.threads = fi.as_uint32_positive_or_throw(name);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void check_walk_root(const walk_params& params) {
+    if (params.path.empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    // fail early if root is not a readable directory
+    dir_reader reader(params.path);
+    (void) reader;
+}
+
+sl::json::value walk_entry_to_json(walk_entry&& en) {
+    return {
+        { "path", std::move(en.path) },
+        { "type", entry_type_name(en.type) },
+        { "depth", en.depth }
+    };
+}
+
+sl::json::value walk_errors_to_json(std::vector<walk_error>&& errors) {
+    auto vec = std::vector<sl::json::value>();
+    for (auto& er : errors) {
+        vec.emplace_back(sl::json::value({
+            { "path", std::move(er.path) },
+            { "message", std::move(er.message) }
+        }));
+    }
+    return sl::json::value(std::move(vec));
+}
+
+} // namespace
+
+support::buffer walk(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto params = walk_params();
+    uint32_t max_entries = std::numeric_limits<uint32_t>::max();
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if (parse_walk_field(fi, params)) {
+            continue;
+        } else if ("maxEntries" == name) {
+            max_entries = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    // call, entries order is not deterministic
+    try {
+        check_walk_root(params);
+        auto pool = shared_task_pool();
+        size_t workers = 0 != params.threads ? params.threads : pool->size() + 1;
+        auto collected = std::vector<std::vector<walk_entry>>();
+        collected.resize(workers);
+        std::atomic<size_t> count{0};
+        std::atomic<bool> truncated{false};
+        dir_walker walker(params.path, params.opts, workers,
+                [&collected, &count, &truncated, max_entries](size_t idx, walk_entry&& en) {
+            if (count.fetch_add(1) >= max_entries) {
+                truncated.store(true);
+                return false;
+            }
+            collected[idx].emplace_back(std::move(en));
+            return true;
+        });
+        pool->parallel_for(workers, workers, [&walker](size_t idx) {
+            walker.work(idx);
+        });
+        auto entries = std::vector<sl::json::value>();
+        for (auto& vec : collected) {
+            for (auto& en : vec) {
+                entries.emplace_back(walk_entry_to_json(std::move(en)));
+            }
+        }
+        return support::make_json_buffer({
+            { "entries", std::move(entries) },
+            { "truncated", truncated.load() },
+            { "errors", walk_errors_to_json(walker.collected_errors()) }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer open_walker(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto params = walk_params();
+    for (const sl::json::field& fi : json.as_object()) {
+        if (!parse_walk_field(fi, params)) {
+            throw support::exception(TRACEMSG("Unknown data field: [" + fi.name() + "]"));
+        }
+    }
+    // call, walk runs on its own threads and blocks when consumer is behind
+    try {
+        check_walk_root(params);
+        size_t threads = 0 != params.threads ? params.threads :
+                std::max(2u, std::thread::hardware_concurrency());
+        auto reg = walker_registry();
+        auto walker = new dir_walk_stream(params.path, params.opts, threads, 16384);
+        auto handle = reg->put(walker);
+        return support::make_json_buffer({
+            { "walkerHandle", handle }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer walk_next(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    uint32_t max_entries = 1024;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("walkerHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("maxEntries" == name) {
+            max_entries = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'walkerHandle' not specified"));
+    // get handle, walker is used exclusively until returned back
+    auto reg = walker_registry();
+    auto walker = reg->remove(handle);
+    if (nullptr == walker) throw support::exception(TRACEMSG(
+            "Invalid 'walkerHandle' parameter specified"));
+    auto deferred = sl::support::defer([reg, walker]() STATICLIB_NOEXCEPT {
+        reg->put(walker);
+    });
+    // call, 'done' is set with the last page
+    try {
+        auto entries = std::vector<sl::json::value>();
+        for (auto& en : walker->next(max_entries)) {
+            entries.emplace_back(walk_entry_to_json(std::move(en)));
+        }
+        auto done = entries.empty();
+        return support::make_json_buffer({
+            { "entries", std::move(entries) },
+            { "done", done },
+            { "errors", walk_errors_to_json(done ? walker->collected_errors() : std::vector<walk_error>()) }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer close_walker(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("walkerHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'walkerHandle' not specified"));
+    // call, pending walk is stopped
+    auto reg = walker_registry();
+    auto walker = reg->remove(handle);
+    if (nullptr == walker) throw support::exception(TRACEMSG(
+            "Invalid 'walkerHandle' parameter specified"));
+    delete walker;
+    return support::make_null_buffer();
+}
+
+namespace { // anonymous
+
+// regular files under the root, sorted for deterministic output
+std::vector<std::string> list_tree_files(const std::string& root, const walk_options& opts, size_t workers) {
+    auto collected = std::vector<std::vector<std::string>>();
+    collected.resize(workers);
+    dir_walker walker(root, opts, workers, [&collected, &root](size_t idx, walk_entry&& en) {
+        if (entry_type::file == en.type) {
+            collected[idx].emplace_back(root + "/" + en.path);
+        }
+        return true;
+    });
+    shared_task_pool()->parallel_for(workers, workers, [&walker](size_t idx) {
+        walker.work(idx);
+    });
+    auto res = std::vector<std::string>();
+    for (auto& vec : collected) {
+        std::move(vec.begin(), vec.end(), std::back_inserter(res));
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+} // namespace
+
+support::buffer grep(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    const std::vector<sl::json::value>* paths_json = nullptr;
+    auto rdir = std::ref(sl::utils::empty_string());
+    auto walk_opts = walk_options();
+    auto opts = grep_options();
+    // literal search unless 'regex' is enabled or 'fixed' is disabled
+    auto fixed = true;
+    auto fixed_specified = false;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("paths" == name) {
+            paths_json = std::addressof(fi.as_array_or_throw(name));
+        } else if ("dir" == name) {
+            rdir = fi.as_string_nonempty_or_throw(name);
+        } else if ("glob" == name) {
+            walk_opts.glob = fi.as_string_nonempty_or_throw(name);
+        } else if ("maxDepth" == name) {
+            walk_opts.max_depth = fi.as_uint32_positive_or_throw(name);
+        } else if ("pattern" == name) {
+            opts.pattern = fi.as_string_nonempty_or_throw(name);
+        } else if ("fixed" == name) {
+            fixed = fi.as_bool_or_throw(name);
+            fixed_specified = true;
+        } else if ("regex" == name) {
+            opts.regex = fi.as_bool_or_throw(name);
+        } else if ("maxMatches" == name) {
+            opts.max_matches = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (nullptr == paths_json && rdir.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'paths' or 'dir' not specified"));
+    if (nullptr != paths_json && !rdir.get().empty()) throw support::exception(TRACEMSG(
+            "Parameters 'paths' and 'dir' cannot be specified together"));
+    if (opts.pattern.empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'pattern' not specified"));
+    if (fixed_specified && fixed && opts.regex) throw support::exception(TRACEMSG(
+            "Parameters 'fixed' and 'regex' cannot be enabled together"));
+    opts.regex = opts.regex || !fixed;
+    const std::string& dir = rdir.get();
+    // call, only matching lines are returned
+    try {
+        auto workers = shared_task_pool()->size() + 1;
+        auto paths = std::vector<std::string>();
+        if (nullptr != paths_json) {
+            for (auto& pa : *paths_json) {
+                paths.emplace_back(pa.as_string_nonempty_or_throw("paths"));
+            }
+        } else {
+            paths = list_tree_files(dir, walk_opts, workers);
+        }
+        auto res = grep_files(paths, opts, workers);
+        call_metrics::record_read(res.bytes_read);
+        auto matches = std::vector<sl::json::value>();
+        for (auto& ma : res.matches) {
+            matches.emplace_back(sl::json::value({
+                { "path", paths[ma.file] },
+                { "line", ma.line },
+                { "offset", ma.offset },
+                { "text", std::move(ma.text) }
+            }));
+        }
+        auto errors = std::vector<sl::json::value>();
+        for (auto& er : res.errors) {
+            errors.emplace_back(sl::json::value({
+                { "path", std::move(er.path) },
+                { "message", std::move(er.message) }
+            }));
+        }
+        return support::make_json_buffer({
+            { "matches", std::move(matches) },
+            { "truncated", res.truncated },
+            { "errors", std::move(errors) }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+namespace { // anonymous
+
+struct batch_op {
+    const char* name;
+    support::buffer(*fun)(sl::io::span<const char>);
+    bool json_result;
+};
+
+// stateful (writer, line reader, walker) calls are not allowed in batches
+const std::vector<batch_op>& batch_ops() {
+    static std::vector<batch_op> ops = {
+        { "fs_exists", exists, true },
+        { "fs_mkdir", mkdir, false },
+        { "fs_readdir", readdir, true },
+        { "fs_read_file", read_file, false },
+        { "fs_write_file", write_file, false },
+        { "fs_read_lines", read_lines, true },
+        { "fs_realpath", realpath, false },
+        { "fs_rename", rename, false },
+        { "fs_rmdir", rmdir, false },
+        { "fs_stat", stat, true },
+        { "fs_hash", hash, true },
+        { "fs_unlink", unlink, false },
+        { "fs_copy_file", copy_file, false },
+        { "fs_copy_tree", copy_tree, true },
+        { "fs_mkdirs", mkdirs, true },
+        { "fs_rmtree", rmtree, true },
+        { "fs_symlink", symlink, false },
+        { "fs_insert_file", insert_file, false },
+        { "fs_resize_file", resize_file, false },
+        { "fs_walk", walk, true }
+    };
+    return ops;
+}
+
+// 'fields' are prepended to the result
+sl::json::value make_batch_result(std::vector<sl::json::field>&& fields,
+        const std::string& field_name, sl::json::value&& val) {
+    fields.emplace_back(field_name, std::move(val));
+    return sl::json::value(std::move(fields));
+}
+
+sl::json::value run_batch_op(const sl::json::value& item, std::vector<sl::json::field>&& fields) {
+    try {
+        auto rop = std::ref(sl::utils::empty_string());
+        auto args = std::string("{}");
+        for (const sl::json::field& fi : item.as_object_or_throw("ops")) {
+            auto& name = fi.name();
+            if ("op" == name) {
+                rop = fi.as_string_nonempty_or_throw(name);
+            } else if ("args" == name) {
+                args = fi.val().dumps();
+            } else {
+                throw support::exception(TRACEMSG("Unknown batch item field: [" + name + "]"));
+            }
+        }
+        const std::string& op = rop.get();
+        if (op.empty()) throw support::exception(TRACEMSG(
+                "Required batch item parameter 'op' not specified"));
+        auto& ops = batch_ops();
+        auto it = std::find_if(ops.begin(), ops.end(), [&op](const batch_op& bo) {
+            return op == bo.name;
+        });
+        if (ops.end() == it) throw support::exception(TRACEMSG(
+                "Unsupported batch operation: [" + op + "]"));
+        // items are measured under their own names
+        auto metrics = shared_call_metrics();
+        auto buf = call_measured(*metrics, metrics->find_op(op), it->fun, {args.data(), args.length()});
+        if (nullptr == buf.data()) {
+            return make_batch_result(std::move(fields), "result", sl::json::value());
+        }
+        auto deferred = sl::support::defer([buf]() STATICLIB_NOEXCEPT {
+            wilton_free(buf.data());
+        });
+        if (it->json_result) {
+            return make_batch_result(std::move(fields), "result",
+                    sl::json::load({buf.data(), buf.size()}));
+        }
+        return make_batch_result(std::move(fields), "result",
+                sl::json::value(std::string(buf.data(), buf.size())));
+    } catch (const std::exception& e) {
+        return make_batch_result(std::move(fields), "error", sl::json::value(std::string(e.what())));
+    }
+}
+
+} // namespace
+
+support::buffer batch(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    const std::vector<sl::json::value>* ops = nullptr;
+    auto parallel = false;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("ops" == name) {
+            ops = std::addressof(fi.as_array_or_throw(name));
+        } else if ("parallel" == name) {
+            parallel = fi.as_bool_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (nullptr == ops) throw support::exception(TRACEMSG(
+            "Required parameter 'ops' not specified"));
+    // call, errors are reported per item
+    auto results = std::vector<sl::json::value>();
+    results.resize(ops->size());
+    auto run = [ops, &results](size_t idx) {
+        results[idx] = run_batch_op(ops->at(idx), std::vector<sl::json::field>());
+    };
+    if (parallel && ops->size() > 1) {
+        auto pool = shared_task_pool();
+        pool->parallel_for(ops->size(), pool->size() + 1, run);
+    } else {
+        for (size_t i = 0; i < ops->size(); i++) {
+            run(i);
+        }
+    }
+    auto res = sl::json::value(std::move(results));
+    return support::make_json_buffer(res);
+}
+
+namespace { // anonymous
+
+// initialized from wilton_module_init
+std::shared_ptr<sharded_registry<async_queue>> queue_registry() {
+    static auto registry = std::make_shared<sharded_registry<async_queue>>();
+    return registry;
+}
+
+// initialized lazily, size can be changed with fs_configure_async before first use
+std::mutex& async_pool_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::shared_ptr<task_pool>& async_pool_ref() {
+    static auto pool = std::shared_ptr<task_pool>();
+    return pool;
+}
+
+// operations mostly wait on I/O, so the pool is much bigger than the CPU-sized one
+size_t& async_pool_threads() {
+    static size_t threads = std::max(32u, 4 * std::thread::hardware_concurrency());
+    return threads;
+}
+
+// separate from the shared pool, so blocking operations do not
+// take the helper threads of parallel calls
+std::shared_ptr<task_pool> async_io_pool() {
+    std::lock_guard<std::mutex> guard{async_pool_mutex()};
+    auto& pool = async_pool_ref();
+    if (nullptr == pool.get()) {
+        pool = std::make_shared<task_pool>(async_pool_threads());
+    }
+    return pool;
+}
+
+std::shared_ptr<async_queue> find_queue(int64_t handle) {
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'queueHandle' not specified"));
+    auto queue = queue_registry()->get(handle);
+    if (nullptr == queue.get()) throw support::exception(TRACEMSG(
+            "Invalid 'queueHandle' parameter specified"));
+    return queue;
+}
+
+int64_t submit_async_op(async_queue& queue, const sl::json::value& item) {
+    // request data is not available after the call returns
+    auto item_copy = std::make_shared<sl::json::value>(item.clone());
+    return queue.submit([item_copy](int64_t ticket) {
+        auto fields = std::vector<sl::json::field>();
+        fields.emplace_back("ticket", ticket);
+        return run_batch_op(*item_copy, std::move(fields));
+    });
+}
+
+std::vector<int64_t> parse_tickets(const std::vector<sl::json::value>& tickets_json) {
+    auto tickets = std::vector<int64_t>();
+    for (auto& ti : tickets_json) {
+        tickets.push_back(ti.as_int64_or_throw("tickets"));
+    }
+    return tickets;
+}
+
+// same meaning for all waiting calls, zero returns immediately
+std::chrono::milliseconds parse_timeout(const sl::json::field& fi) {
+    return std::chrono::milliseconds(fi.as_uint32_or_throw(fi.name()));
+}
+
+} // namespace
+
+support::buffer configure_async(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    uint32_t threads = 0;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("threads" == name) {
+            threads = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (0 == threads) throw support::exception(TRACEMSG(
+            "Required parameter 'threads' not specified"));
+    // call, running pool is not resized
+    std::lock_guard<std::mutex> guard{async_pool_mutex()};
+    auto& pool = async_pool_ref();
+    if (nullptr != pool.get() && pool->size() != threads) throw support::exception(TRACEMSG(
+            "Async operations pool is already started," +
+            " threads: [" + sl::support::to_string(pool->size()) + "]"));
+    async_pool_threads() = threads;
+    return support::make_null_buffer();
+}
+
+support::buffer open_queue(sl::io::span<const char>) {
+    // call, completions are visible only through this handle
+    try {
+        auto queue = std::make_shared<async_queue>(async_io_pool());
+        auto handle = queue_registry()->put(std::move(queue));
+        return support::make_json_buffer({
+            { "queueHandle", handle }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer submit(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    const std::vector<sl::json::value>* ops = nullptr;
+    auto single = std::vector<sl::json::field>();
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("queueHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("op" == name || "args" == name) {
+            // validated on execution, same as in batch
+            single.emplace_back(name, fi.val().clone());
+        } else if ("ops" == name) {
+            ops = std::addressof(fi.as_array_or_throw(name));
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (single.empty() == (nullptr == ops)) throw support::exception(TRACEMSG(
+            "Either 'op' or 'ops' parameter must be specified"));
+    auto queue = find_queue(handle);
+    // call, operations results are collected with fs_poll/fs_wait
+    try {
+        if (!single.empty()) {
+            auto item = sl::json::value(std::move(single));
+            auto ticket = submit_async_op(*queue, item);
+            return support::make_json_buffer({
+                { "ticket", ticket }
+            });
+        }
+        auto tickets = std::vector<sl::json::value>();
+        for (auto& item : *ops) {
+            tickets.emplace_back(submit_async_op(*queue, item));
+        }
+        return support::make_json_buffer({
+            { "tickets", std::move(tickets) }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer poll(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    uint32_t max_completions = 1024;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("queueHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("maxCompletions" == name) {
+            max_completions = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    auto queue = find_queue(handle);
+    // call
+    try {
+        auto res = sl::json::value(queue->poll(max_completions));
+        return support::make_json_buffer(res);
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer wait(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    const std::vector<sl::json::value>* tickets_json = nullptr;
+    uint32_t max_completions = 1024;
+    // no limit unless specified
+    auto timeout = std::chrono::milliseconds::max();
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("queueHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("tickets" == name) {
+            tickets_json = std::addressof(fi.as_array_or_throw(name));
+        } else if ("maxCompletions" == name) {
+            max_completions = fi.as_uint32_positive_or_throw(name);
+        } else if ("timeoutMillis" == name) {
+            timeout = parse_timeout(fi);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    auto queue = find_queue(handle);
+    // call, without tickets waits for any completion
+    try {
+        if (nullptr == tickets_json) {
+            auto res = sl::json::value(queue->wait_any(max_completions, timeout));
+            return support::make_json_buffer(res);
+        }
+        auto res = sl::json::value(queue->wait_all(parse_tickets(*tickets_json), timeout));
+        return support::make_json_buffer(res);
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer discard(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    const std::vector<sl::json::value>* tickets_json = nullptr;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("queueHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("tickets" == name) {
+            tickets_json = std::addressof(fi.as_array_or_throw(name));
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (nullptr == tickets_json) throw support::exception(TRACEMSG(
+            "Required parameter 'tickets' not specified"));
+    auto queue = find_queue(handle);
+    // call, operations not started yet are cancelled
+    try {
+        auto count = queue->discard(parse_tickets(*tickets_json));
+        return support::make_json_buffer({
+            { "discarded", static_cast<int64_t>(count) }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer close_queue(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("queueHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'queueHandle' not specified"));
+    // call, running operations complete on the pool and their results are dropped
+    auto queue = queue_registry()->remove(handle);
+    if (nullptr == queue.get()) throw support::exception(TRACEMSG(
+            "Invalid 'queueHandle' parameter specified"));
+    queue->close();
+    return support::make_null_buffer();
+}
+
+namespace { // anonymous
+
+// initialized from wilton_module_init
+std::shared_ptr<support::handle_registry<fs_watcher>> watcher_registry() {
+    static auto registry = std::make_shared<support::handle_registry<fs_watcher>>(
+        [](fs_watcher* watcher) STATICLIB_NOEXCEPT {
+            delete watcher;
+        });
+    return registry;
+}
+
+} // namespace
+
+support::buffer watch(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rpath = std::ref(sl::utils::empty_string());
+    auto recursive = false;
+    uint32_t events = 0;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("recursive" == name) {
+            recursive = fi.as_bool_or_throw(name);
+        } else if ("events" == name) {
+            for (auto& ev : fi.as_array_or_throw(name)) {
+                events |= parse_watch_event(ev.as_string_nonempty_or_throw(name));
+            }
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    const std::string& path = rpath.get();
+    // call, all events are reported when none specified
+    try {
+        auto reg = watcher_registry();
+        auto watcher = new fs_watcher(path, recursive, events);
+        auto handle = reg->put(watcher);
+        return support::make_json_buffer({
+            { "watchHandle", handle },
+            { "watchedDirectories", watcher->watched_dirs_count() }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer read_events(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto timeout = std::chrono::milliseconds(0);
+    uint32_t max_events = 1024;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("watchHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("timeoutMillis" == name) {
+            timeout = parse_timeout(fi);
+        } else if ("maxEvents" == name) {
+            max_events = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'watchHandle' not specified"));
+    // get handle, watcher is used exclusively until returned back
+    auto reg = watcher_registry();
+    auto watcher = reg->remove(handle);
+    if (nullptr == watcher) throw support::exception(TRACEMSG(
+            "Invalid 'watchHandle' parameter specified"));
+    auto deferred = sl::support::defer([reg, watcher]() STATICLIB_NOEXCEPT {
+        reg->put(watcher);
+    });
+    // call, zero timeout returns immediately
+    try {
+        auto res = std::vector<sl::json::value>();
+        for (auto& ev : watcher->read_events(timeout, max_events)) {
+            auto names = std::vector<sl::json::value>();
+            for (auto& na : watch_event_names(ev.flags)) {
+                names.emplace_back(std::move(na));
+            }
+            res.emplace_back(sl::json::value({
+                { "path", std::move(ev.path) },
+                { "events", std::move(names) },
+                { "isDirectory", ev.directory }
+            }));
+        }
+        return support::make_json_buffer(sl::json::value(std::move(res)));
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer close_watch(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("watchHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'watchHandle' not specified"));
+    // call, pending events are discarded
+    auto reg = watcher_registry();
+    auto watcher = reg->remove(handle);
+    if (nullptr == watcher) throw support::exception(TRACEMSG(
+            "Invalid 'watchHandle' parameter specified"));
+    delete watcher;
+    return support::make_null_buffer();
+}
+
+namespace { // anonymous
+
+// initialized from wilton_module_init
+std::shared_ptr<support::handle_registry<tail_follower>> tail_registry() {
+    static auto registry = std::make_shared<support::handle_registry<tail_follower>>(
+        [](tail_follower* follower) STATICLIB_NOEXCEPT {
+            delete follower;
+        });
+    return registry;
+}
+
+// returned lines are accounted as read bytes
+sl::json::value lines_to_json(std::vector<std::string>& lines) {
+    auto res = std::vector<sl::json::value>();
+    res.reserve(lines.size());
+    uint64_t bytes = 0;
+    for (auto& li : lines) {
+        bytes += li.length();
+        res.emplace_back(std::move(li));
+    }
+    call_metrics::record_read(bytes);
+    return sl::json::value(std::move(res));
+}
+
+} // namespace
+
+support::buffer tail(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rpath = std::ref(sl::utils::empty_string());
+    uint32_t count = 10;
+    auto follow = false;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("lines" == name) {
+            count = fi.as_uint32_or_throw(name);
+        } else if ("follow" == name) {
+            follow = fi.as_bool_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    const std::string& path = rpath.get();
+    // call, in follow mode unterminated last line is reported by fs_tail_next
+    try {
+        auto file = native_file::open_read(path);
+        auto res = read_tail_lines(file, count, !follow);
+        if (!follow) {
+            return support::make_json_buffer({
+                { "lines", lines_to_json(res.lines) }
+            });
+        }
+        auto reg = tail_registry();
+        auto handle = reg->put(new tail_follower(path, res.end_offset));
+        return support::make_json_buffer({
+            { "lines", lines_to_json(res.lines) },
+            { "tailHandle", handle }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer tail_next(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    auto timeout = std::chrono::milliseconds(0);
+    uint32_t max_lines = 1024;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("tailHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else if ("timeoutMillis" == name) {
+            timeout = parse_timeout(fi);
+        } else if ("maxLines" == name) {
+            max_lines = fi.as_uint32_positive_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'tailHandle' not specified"));
+    // get handle, follower is used exclusively until returned back
+    auto reg = tail_registry();
+    auto follower = reg->remove(handle);
+    if (nullptr == follower) throw support::exception(TRACEMSG(
+            "Invalid 'tailHandle' parameter specified"));
+    auto deferred = sl::support::defer([reg, follower]() STATICLIB_NOEXCEPT {
+        reg->put(follower);
+    });
+    // call, waits for new lines up to the timeout
+    try {
+        auto res = follower->next(max_lines, timeout);
+        return support::make_json_buffer({
+            { "lines", lines_to_json(res.lines) },
+            { "rotated", res.rotated }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer close_tail(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    int64_t handle = -1;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("tailHandle" == name) {
+            handle = fi.as_int64_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (-1 == handle) throw support::exception(TRACEMSG(
+            "Required parameter 'tailHandle' not specified"));
+    // call
+    auto reg = tail_registry();
+    auto follower = reg->remove(handle);
+    if (nullptr == follower) throw support::exception(TRACEMSG(
+            "Invalid 'tailHandle' parameter specified"));
+    delete follower;
+    return support::make_null_buffer();
+}
+
+namespace { // anonymous
+
+// initialized from wilton_module_init
+std::shared_ptr<line_index_cache> shared_line_index_cache() {
+    static auto cache = std::make_shared<line_index_cache>(64);
+    return cache;
+}
+
+file_stat stat_indexed_file(const std::string& path) {
+    auto st = file_stat();
+    if (!stat_path(path, true, st)) throw support::exception(TRACEMSG(
+            "Error obtaining file status, path: [" + path + "]," +
+            " error: [" + ::strerror(errno) + "]"));
+    return st;
+}
+
+std::shared_ptr<const line_index> build_line_index_file(const std::string& path, const std::string& index_path) {
+    auto pool = shared_task_pool();
+    auto index = std::make_shared<const line_index>(line_index::build(path, pool->size() + 1));
+    if (!index_path.empty()) {
+        index->save(index_path);
+    }
+    return index;
+}
+
+std::shared_ptr<const line_index> rebuild_line_index(const std::string& path, const std::string& index_path) {
+    auto index = build_line_index_file(path, index_path);
+    shared_line_index_cache()->put(path, index);
+    return index;
+}
+
+// cached index is used first, then the sidecar file, index is built when both are stale;
+// concurrent calls for the same file share a single load or build
+std::shared_ptr<const line_index> find_line_index(const std::string& path, const std::string& index_path) {
+    auto current = stat_indexed_file(path);
+    auto cache = shared_line_index_cache();
+    auto load_or_build = [&path, &index_path, &current]() -> std::shared_ptr<const line_index> {
+        auto ist = file_stat();
+        if (!index_path.empty() && stat_path(index_path, true, ist)) {
+            auto index = std::shared_ptr<const line_index>();
+            try {
+                index = std::make_shared<const line_index>(line_index::load(index_path));
+            } catch (const std::exception&) {
+                // corrupted sidecar is overwritten below
+            }
+            if (nullptr != index.get() && index->matches(current)) {
+                return index;
+            }
+        }
+        return build_line_index_file(path, index_path);
+    };
+    return cache->get_or_build(path, current, load_or_build);
+}
+
+} // namespace
+
+support::buffer build_line_index(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rpath = std::ref(sl::utils::empty_string());
+    auto rindex_path = std::ref(sl::utils::empty_string());
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("indexPath" == name) {
+            rindex_path = fi.as_string_nonempty_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    const std::string& path = rpath.get();
+    const std::string& index_path = rindex_path.get();
+    // call, index is always rebuilt and kept in memory, sidecar file is optional
+    try {
+        auto index = rebuild_line_index(path, index_path);
+        return support::make_json_buffer({
+            { "lines", static_cast<int64_t>(index->lines_count()) },
+            { "size", static_cast<int64_t>(index->file_size()) },
+            { "indexBytes", static_cast<int64_t>(index->memory_size()) }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer read_line_range(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto rpath = std::ref(sl::utils::empty_string());
+    auto rindex_path = std::ref(sl::utils::empty_string());
+    int64_t from = 0;
+    uint32_t count = 1024;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("path" == name) {
+            rpath = fi.as_string_nonempty_or_throw(name);
+        } else if ("indexPath" == name) {
+            rindex_path = fi.as_string_nonempty_or_throw(name);
+        } else if ("from" == name) {
+            from = fi.as_int64_or_throw(name);
+        } else if ("count" == name) {
+            count = fi.as_uint32_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    if (rpath.get().empty()) throw support::exception(TRACEMSG(
+            "Required parameter 'path' not specified"));
+    if (from < 0) throw support::exception(TRACEMSG(
+            "Invalid 'from' parameter specified: [" + sl::support::to_string(from) + "]"));
+    const std::string& path = rpath.get();
+    const std::string& index_path = rindex_path.get();
+    // call, line numbers are zero-based
+    try {
+        auto index = find_line_index(path, index_path);
+        auto file = native_file::open_read(path);
+        auto lines = read_indexed_lines(file, *index, static_cast<uint64_t>(from), count);
+        return support::make_json_buffer({
+            { "lines", lines_to_json(lines) },
+            { "totalLines", static_cast<int64_t>(index->lines_count()) }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+support::buffer metrics(sl::io::span<const char> data) {
+    // json parse
+    auto json = sl::json::load(data);
+    auto reset = false;
+    for (const sl::json::field& fi : json.as_object()) {
+        auto& name = fi.name();
+        if ("reset" == name) {
+            reset = fi.as_bool_or_throw(name);
+        } else {
+            throw support::exception(TRACEMSG("Unknown data field: [" + name + "]"));
+        }
+    }
+    // call, latencies are reported as highest values of histogram buckets
+    try {
+        auto snap = shared_call_metrics()->snapshot(reset);
+        auto ops = std::vector<sl::json::field>();
+        for (auto& om : snap.ops) {
+            auto& lb = om.latency_buckets;
+            ops.emplace_back(om.name, sl::json::value({
+                { "calls", static_cast<int64_t>(om.calls) },
+                { "errors", static_cast<int64_t>(om.errors) },
+                { "bytesRead", static_cast<int64_t>(om.bytes_read) },
+                { "bytesWritten", static_cast<int64_t>(om.bytes_written) },
+                { "latencyNanos", sl::json::value({
+                    { "mean", static_cast<int64_t>(om.total_nanos / om.calls) },
+                    { "p50", static_cast<int64_t>(latency_quantile(lb, 0.5)) },
+                    { "p90", static_cast<int64_t>(latency_quantile(lb, 0.9)) },
+                    { "p99", static_cast<int64_t>(latency_quantile(lb, 0.99)) },
+                    { "p999", static_cast<int64_t>(latency_quantile(lb, 0.999)) },
+                    { "max", static_cast<int64_t>(latency_quantile(lb, 1.0)) }
+                }) }
+            }));
+        }
+        return support::make_json_buffer({
+            { "sinceMillis", snap.since_millis },
+            { "ops", sl::json::value(std::move(ops)) }
+        });
+    } catch (const std::exception& e) {
+        throw support::exception(TRACEMSG(e.what()));
+    }
+}
+
+namespace { // anonymous
+
+// all calls are measured, see fs_metrics
+void register_measured(const std::string& name, support::buffer(*fun)(sl::io::span<const char>)) {
+    auto metrics = shared_call_metrics();
+    auto op_id = metrics->register_op(name);
+    support::register_wiltoncall(name, [metrics, op_id, fun](sl::io::span<const char> data) {
+        return call_measured(*metrics, op_id, fun, data);
+    });
+}
+
+} // namespace
 
 } // namespace
 }
@@ -594,24 +2737,68 @@ support::buffer resize_file(sl::io::span<const char> data) {
 extern "C" char* wilton_module_init() {
     try {
         wilton::fs::local_registry();
+        wilton::fs::writer_registry();
+        wilton::fs::line_reader_registry();
+        wilton::fs::walker_registry();
+        wilton::fs::queue_registry();
+        wilton::fs::watcher_registry();
+        wilton::fs::tail_registry();
+        wilton::fs::shared_line_index_cache();
+        wilton::fs::shared_trash_purger();
+        wilton::fs::shared_call_metrics();
 
-        wilton::support::register_wiltoncall("fs_exists", wilton::fs::exists);
-        wilton::support::register_wiltoncall("fs_mkdir", wilton::fs::mkdir);
-        wilton::support::register_wiltoncall("fs_readdir", wilton::fs::readdir);
-        wilton::support::register_wiltoncall("fs_read_file", wilton::fs::read_file);
-        wilton::support::register_wiltoncall("fs_read_lines", wilton::fs::read_lines);
-        wilton::support::register_wiltoncall("fs_realpath", wilton::fs::realpath);
-        wilton::support::register_wiltoncall("fs_rename", wilton::fs::rename);
-        wilton::support::register_wiltoncall("fs_rmdir", wilton::fs::rmdir);
-        wilton::support::register_wiltoncall("fs_stat", wilton::fs::stat);
-        wilton::support::register_wiltoncall("fs_unlink", wilton::fs::unlink);
-        wilton::support::register_wiltoncall("fs_copy_file", wilton::fs::copy_file);
-        wilton::support::register_wiltoncall("fs_open_tl_file_writer", wilton::fs::open_tl_file_writer);
-        wilton::support::register_wiltoncall("fs_append_tl_file_writer", wilton::fs::append_tl_file_writer);
-        wilton::support::register_wiltoncall("fs_close_tl_file_writer", wilton::fs::close_tl_file_writer);
-        wilton::support::register_wiltoncall("fs_symlink", wilton::fs::symlink);
-        wilton::support::register_wiltoncall("fs_insert_file", wilton::fs::insert_file);
-        wilton::support::register_wiltoncall("fs_resize_file", wilton::fs::resize_file);
+        wilton::fs::register_measured("fs_exists", wilton::fs::exists);
+        wilton::fs::register_measured("fs_mkdir", wilton::fs::mkdir);
+        wilton::fs::register_measured("fs_readdir", wilton::fs::readdir);
+        wilton::fs::register_measured("fs_read_file", wilton::fs::read_file);
+        wilton::fs::register_measured("fs_write_file", wilton::fs::write_file);
+        wilton::fs::register_measured("fs_configure_cache", wilton::fs::configure_cache);
+        wilton::fs::register_measured("fs_cache_stats", wilton::fs::cache_stats);
+        wilton::fs::register_measured("fs_read_lines", wilton::fs::read_lines);
+        wilton::fs::register_measured("fs_open_line_reader", wilton::fs::open_line_reader);
+        wilton::fs::register_measured("fs_read_lines_batch", wilton::fs::read_lines_batch);
+        wilton::fs::register_measured("fs_close_line_reader", wilton::fs::close_line_reader);
+        wilton::fs::register_measured("fs_realpath", wilton::fs::realpath);
+        wilton::fs::register_measured("fs_rename", wilton::fs::rename);
+        wilton::fs::register_measured("fs_rmdir", wilton::fs::rmdir);
+        wilton::fs::register_measured("fs_stat", wilton::fs::stat);
+        wilton::fs::register_measured("fs_hash", wilton::fs::hash);
+        wilton::fs::register_measured("fs_unlink", wilton::fs::unlink);
+        wilton::fs::register_measured("fs_copy_file", wilton::fs::copy_file);
+        wilton::fs::register_measured("fs_copy_tree", wilton::fs::copy_tree);
+        wilton::fs::register_measured("fs_mkdirs", wilton::fs::mkdirs);
+        wilton::fs::register_measured("fs_rmtree", wilton::fs::rmtree);
+        wilton::fs::register_measured("fs_open_tl_file_writer", wilton::fs::open_tl_file_writer);
+        wilton::fs::register_measured("fs_append_tl_file_writer", wilton::fs::append_tl_file_writer);
+        wilton::fs::register_measured("fs_close_tl_file_writer", wilton::fs::close_tl_file_writer);
+        wilton::fs::register_measured("fs_open_writer", wilton::fs::open_writer);
+        wilton::fs::register_measured("fs_write", wilton::fs::write);
+        wilton::fs::register_measured("fs_close_writer", wilton::fs::close_writer);
+        wilton::fs::register_measured("fs_symlink", wilton::fs::symlink);
+        wilton::fs::register_measured("fs_insert_file", wilton::fs::insert_file);
+        wilton::fs::register_measured("fs_resize_file", wilton::fs::resize_file);
+        wilton::fs::register_measured("fs_batch", wilton::fs::batch);
+        wilton::fs::register_measured("fs_configure_async", wilton::fs::configure_async);
+        wilton::fs::register_measured("fs_open_queue", wilton::fs::open_queue);
+        wilton::fs::register_measured("fs_submit", wilton::fs::submit);
+        wilton::fs::register_measured("fs_poll", wilton::fs::poll);
+        wilton::fs::register_measured("fs_wait", wilton::fs::wait);
+        wilton::fs::register_measured("fs_discard", wilton::fs::discard);
+        wilton::fs::register_measured("fs_close_queue", wilton::fs::close_queue);
+        wilton::fs::register_measured("fs_walk", wilton::fs::walk);
+        wilton::fs::register_measured("fs_open_walker", wilton::fs::open_walker);
+        wilton::fs::register_measured("fs_walk_next", wilton::fs::walk_next);
+        wilton::fs::register_measured("fs_close_walker", wilton::fs::close_walker);
+        wilton::fs::register_measured("fs_grep", wilton::fs::grep);
+        wilton::fs::register_measured("fs_watch", wilton::fs::watch);
+        wilton::fs::register_measured("fs_read_events", wilton::fs::read_events);
+        wilton::fs::register_measured("fs_close_watch", wilton::fs::close_watch);
+        wilton::fs::register_measured("fs_tail", wilton::fs::tail);
+        wilton::fs::register_measured("fs_tail_next", wilton::fs::tail_next);
+        wilton::fs::register_measured("fs_close_tail", wilton::fs::close_tail);
+        wilton::fs::register_measured("fs_build_line_index", wilton::fs::build_line_index);
+        wilton::fs::register_measured("fs_read_line_range", wilton::fs::read_line_range);
+        wilton::fs::register_measured("fs_metrics", wilton::fs::metrics);
         return nullptr;
     } catch (const std::exception& e) {
         return wilton::support::alloc_copy(TRACEMSG(e.what() + "\nException raised"));
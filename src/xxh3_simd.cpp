@@ -0,0 +1,464 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   xxh3_simd.cpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#include "xxh3_simd.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "cpu_features.hpp"
+
+#ifdef WILTON_FS_X86
+#include <immintrin.h>
+#endif // WILTON_FS_X86
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+#include <intrin.h>
+#endif // _MSC_VER
+
+namespace wilton {
+namespace fs {
+
+namespace { // anonymous
+
+const uint32_t prime32_1 = 0x9e3779b1u;
+const uint32_t prime32_2 = 0x85ebca77u;
+const uint32_t prime32_3 = 0xc2b2ae3du;
+const uint64_t prime64_1 = 0x9e3779b185ebca87ull;
+const uint64_t prime64_2 = 0xc2b2ae3d27d4eb4full;
+const uint64_t prime64_3 = 0x165667b19e3779f9ull;
+const uint64_t prime64_4 = 0x85ebca77c2b2ae63ull;
+const uint64_t prime64_5 = 0x27d4eb2f165667c5ull;
+
+const size_t stripe_len = 64;
+const size_t secret_size = 192;
+const size_t stripes_per_block = (secret_size - stripe_len) / 8;
+const size_t block_len = stripe_len * stripes_per_block;
+const size_t midsize_max = 240;
+
+alignas(64) const uint8_t default_secret[secret_size] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e
+};
+
+uint32_t read_le32(const uint8_t* ptr) {
+    return static_cast<uint32_t>(ptr[0]) | (static_cast<uint32_t>(ptr[1]) << 8) |
+            (static_cast<uint32_t>(ptr[2]) << 16) | (static_cast<uint32_t>(ptr[3]) << 24);
+}
+
+uint64_t read_le64(const uint8_t* ptr) {
+    return static_cast<uint64_t>(read_le32(ptr)) | (static_cast<uint64_t>(read_le32(ptr + 4)) << 32);
+}
+
+uint64_t rotl64(uint64_t val, int bits) {
+    return (val << bits) | (val >> (64 - bits));
+}
+
+uint64_t swap64(uint64_t val) {
+    val = ((val << 8) & 0xff00ff00ff00ff00ull) | ((val >> 8) & 0x00ff00ff00ff00ffull);
+    val = ((val << 16) & 0xffff0000ffff0000ull) | ((val >> 16) & 0x0000ffff0000ffffull);
+    return (val << 32) | (val >> 32);
+}
+
+uint64_t mul128_fold64(uint64_t lhs, uint64_t rhs) {
+#if defined(__SIZEOF_INT128__)
+    auto product = static_cast<unsigned __int128>(lhs) * rhs;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64))
+    uint64_t hi = 0;
+    auto lo = _umul128(lhs, rhs, std::addressof(hi));
+    return lo ^ hi;
+#else // portable
+    auto lo_lo = (lhs & 0xffffffff) * (rhs & 0xffffffff);
+    auto hi_lo = (lhs >> 32) * (rhs & 0xffffffff);
+    auto lo_hi = (lhs & 0xffffffff) * (rhs >> 32);
+    auto hi_hi = (lhs >> 32) * (rhs >> 32);
+    auto cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+    auto upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    auto lower = (cross << 32) | (lo_lo & 0xffffffff);
+    return lower ^ upper;
+#endif
+}
+
+uint64_t xxh64_avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= prime64_2;
+    h ^= h >> 29;
+    h *= prime64_3;
+    return h ^ (h >> 32);
+}
+
+uint64_t avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= 0x165667919e3779f9ull;
+    return h ^ (h >> 32);
+}
+
+uint64_t rrmxmx(uint64_t h, uint64_t len) {
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= 0x9fb21c651e98df25ull;
+    h ^= (h >> 35) + len;
+    h *= 0x9fb21c651e98df25ull;
+    return h ^ (h >> 28);
+}
+
+uint64_t mix16(const uint8_t* input, const uint8_t* secret) {
+    return mul128_fold64(read_le64(input) ^ read_le64(secret),
+            read_le64(input + 8) ^ read_le64(secret + 8));
+}
+
+uint64_t hash_len_0to16(const uint8_t* input, size_t len, const uint8_t* secret) {
+    if (len > 8) {
+        auto bitflip1 = read_le64(secret + 24) ^ read_le64(secret + 32);
+        auto bitflip2 = read_le64(secret + 40) ^ read_le64(secret + 48);
+        auto input_lo = read_le64(input) ^ bitflip1;
+        auto input_hi = read_le64(input + len - 8) ^ bitflip2;
+        auto acc = len + swap64(input_lo) + input_hi + mul128_fold64(input_lo, input_hi);
+        return avalanche(acc);
+    }
+    if (len >= 4) {
+        auto input1 = read_le32(input);
+        auto input2 = read_le32(input + len - 4);
+        auto bitflip = read_le64(secret + 8) ^ read_le64(secret + 16);
+        auto input64 = input2 + (static_cast<uint64_t>(input1) << 32);
+        return rrmxmx(input64 ^ bitflip, len);
+    }
+    if (len > 0) {
+        uint32_t c1 = input[0];
+        uint32_t c2 = input[len >> 1];
+        uint32_t c3 = input[len - 1];
+        uint32_t combined = (c1 << 16) | (c2 << 24) | c3 | (static_cast<uint32_t>(len) << 8);
+        uint64_t bitflip = read_le32(secret) ^ read_le32(secret + 4);
+        return xxh64_avalanche(combined ^ bitflip);
+    }
+    return xxh64_avalanche(read_le64(secret + 56) ^ read_le64(secret + 64));
+}
+
+uint64_t hash_len_17to128(const uint8_t* input, size_t len, const uint8_t* secret) {
+    uint64_t acc = len * prime64_1;
+    if (len > 32) {
+        if (len > 64) {
+            if (len > 96) {
+                acc += mix16(input + 48, secret + 96);
+                acc += mix16(input + len - 64, secret + 112);
+            }
+            acc += mix16(input + 32, secret + 64);
+            acc += mix16(input + len - 48, secret + 80);
+        }
+        acc += mix16(input + 16, secret + 32);
+        acc += mix16(input + len - 32, secret + 48);
+    }
+    acc += mix16(input, secret);
+    acc += mix16(input + len - 16, secret + 16);
+    return avalanche(acc);
+}
+
+uint64_t hash_len_129to240(const uint8_t* input, size_t len, const uint8_t* secret) {
+    uint64_t acc = len * prime64_1;
+    size_t rounds = len / 16;
+    for (size_t i = 0; i < 8; i++) {
+        acc += mix16(input + 16 * i, secret + 16 * i);
+    }
+    acc = avalanche(acc);
+    for (size_t i = 8; i < rounds; i++) {
+        acc += mix16(input + 16 * i, secret + 16 * (i - 8) + 3);
+    }
+    acc += mix16(input + len - 16, secret + 136 - 17);
+    return avalanche(acc);
+}
+
+uint64_t hash_short(const uint8_t* input, size_t len) {
+    if (len <= 16) {
+        return hash_len_0to16(input, len, default_secret);
+    } else if (len <= 128) {
+        return hash_len_17to128(input, len, default_secret);
+    }
+    return hash_len_129to240(input, len, default_secret);
+}
+
+void accumulate_scalar(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t nb_stripes) {
+    for (size_t n = 0; n < nb_stripes; n++) {
+        auto stripe = input + n * stripe_len;
+        auto key = secret + n * 8;
+        for (size_t i = 0; i < 8; i++) {
+            auto data_val = read_le64(stripe + 8 * i);
+            auto data_key = data_val ^ read_le64(key + 8 * i);
+            acc[i ^ 1] += data_val;
+            acc[i] += (data_key & 0xffffffff) * (data_key >> 32);
+        }
+    }
+}
+
+void scramble_scalar(uint64_t* acc, const uint8_t* secret) {
+    for (size_t i = 0; i < 8; i++) {
+        auto val = acc[i];
+        val ^= val >> 47;
+        val ^= read_le64(secret + 8 * i);
+        acc[i] = val * prime32_1;
+    }
+}
+
+#ifdef WILTON_FS_SSE2
+
+void accumulate_sse2(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t nb_stripes) {
+    auto xacc = reinterpret_cast<__m128i*>(acc);
+    __m128i va[4];
+    for (size_t i = 0; i < 4; i++) {
+        va[i] = _mm_load_si128(xacc + i);
+    }
+    for (size_t n = 0; n < nb_stripes; n++) {
+        auto xinput = reinterpret_cast<const __m128i*>(input + n * stripe_len);
+        auto xsecret = reinterpret_cast<const __m128i*>(secret + n * 8);
+        for (size_t i = 0; i < 4; i++) {
+            auto data_vec = _mm_loadu_si128(xinput + i);
+            auto key_vec = _mm_loadu_si128(xsecret + i);
+            auto data_key = _mm_xor_si128(data_vec, key_vec);
+            auto data_key_lo = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+            auto product = _mm_mul_epu32(data_key, data_key_lo);
+            auto data_swap = _mm_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+            va[i] = _mm_add_epi64(va[i], _mm_add_epi64(product, data_swap));
+        }
+    }
+    for (size_t i = 0; i < 4; i++) {
+        _mm_store_si128(xacc + i, va[i]);
+    }
+}
+
+void scramble_sse2(uint64_t* acc, const uint8_t* secret) {
+    auto xacc = reinterpret_cast<__m128i*>(acc);
+    auto xsecret = reinterpret_cast<const __m128i*>(secret);
+    auto prime32 = _mm_set1_epi32(static_cast<int>(prime32_1));
+    for (size_t i = 0; i < 4; i++) {
+        auto val = _mm_load_si128(xacc + i);
+        val = _mm_xor_si128(val, _mm_srli_epi64(val, 47));
+        val = _mm_xor_si128(val, _mm_loadu_si128(xsecret + i));
+        // 64x32 multiply from two 32x32 ones
+        auto val_hi = _mm_shuffle_epi32(val, _MM_SHUFFLE(0, 3, 0, 1));
+        auto prod_lo = _mm_mul_epu32(val, prime32);
+        auto prod_hi = _mm_mul_epu32(val_hi, prime32);
+        _mm_store_si128(xacc + i, _mm_add_epi64(prod_lo, _mm_slli_epi64(prod_hi, 32)));
+    }
+}
+
+#endif // WILTON_FS_SSE2
+
+#ifdef WILTON_FS_X86
+
+WILTON_FS_TARGET("avx2")
+void accumulate_avx2(uint64_t* acc, const uint8_t* input, const uint8_t* secret, size_t nb_stripes) {
+    auto xacc = reinterpret_cast<__m256i*>(acc);
+    auto va0 = _mm256_load_si256(xacc);
+    auto va1 = _mm256_load_si256(xacc + 1);
+    for (size_t n = 0; n < nb_stripes; n++) {
+        auto xinput = reinterpret_cast<const __m256i*>(input + n * stripe_len);
+        auto xsecret = reinterpret_cast<const __m256i*>(secret + n * 8);
+        auto data0 = _mm256_loadu_si256(xinput);
+        auto data1 = _mm256_loadu_si256(xinput + 1);
+        auto key0 = _mm256_xor_si256(data0, _mm256_loadu_si256(xsecret));
+        auto key1 = _mm256_xor_si256(data1, _mm256_loadu_si256(xsecret + 1));
+        auto prod0 = _mm256_mul_epu32(key0, _mm256_srli_epi64(key0, 32));
+        auto prod1 = _mm256_mul_epu32(key1, _mm256_srli_epi64(key1, 32));
+        auto swap0 = _mm256_shuffle_epi32(data0, _MM_SHUFFLE(1, 0, 3, 2));
+        auto swap1 = _mm256_shuffle_epi32(data1, _MM_SHUFFLE(1, 0, 3, 2));
+        va0 = _mm256_add_epi64(va0, _mm256_add_epi64(prod0, swap0));
+        va1 = _mm256_add_epi64(va1, _mm256_add_epi64(prod1, swap1));
+    }
+    _mm256_store_si256(xacc, va0);
+    _mm256_store_si256(xacc + 1, va1);
+}
+
+WILTON_FS_TARGET("avx2")
+void scramble_avx2(uint64_t* acc, const uint8_t* secret) {
+    auto xacc = reinterpret_cast<__m256i*>(acc);
+    auto xsecret = reinterpret_cast<const __m256i*>(secret);
+    auto prime32 = _mm256_set1_epi32(static_cast<int>(prime32_1));
+    for (size_t i = 0; i < 2; i++) {
+        auto val = _mm256_load_si256(xacc + i);
+        val = _mm256_xor_si256(val, _mm256_srli_epi64(val, 47));
+        val = _mm256_xor_si256(val, _mm256_loadu_si256(xsecret + i));
+        auto val_hi = _mm256_shuffle_epi32(val, _MM_SHUFFLE(0, 3, 0, 1));
+        auto prod_lo = _mm256_mul_epu32(val, prime32);
+        auto prod_hi = _mm256_mul_epu32(val_hi, prime32);
+        _mm256_store_si256(xacc + i, _mm256_add_epi64(prod_lo, _mm256_slli_epi64(prod_hi, 32)));
+    }
+}
+
+#endif // WILTON_FS_X86
+
+struct kernels {
+    void(*accumulate)(uint64_t*, const uint8_t*, const uint8_t*, size_t);
+    void(*scramble)(uint64_t*, const uint8_t*);
+
+    kernels() :
+    accumulate(accumulate_scalar),
+    scramble(scramble_scalar) {
+#ifdef WILTON_FS_SSE2
+        this->accumulate = accumulate_sse2;
+        this->scramble = scramble_sse2;
+#endif // WILTON_FS_SSE2
+#ifdef WILTON_FS_X86
+        if (cpu_has_avx2()) {
+            this->accumulate = accumulate_avx2;
+            this->scramble = scramble_avx2;
+        }
+#endif // WILTON_FS_X86
+    }
+};
+
+const kernels& dispatch() {
+    static kernels kers;
+    return kers;
+}
+
+void init_acc(uint64_t* acc) {
+    acc[0] = prime32_3;
+    acc[1] = prime64_1;
+    acc[2] = prime64_2;
+    acc[3] = prime64_3;
+    acc[4] = prime64_4;
+    acc[5] = prime32_2;
+    acc[6] = prime64_5;
+    acc[7] = prime32_1;
+}
+
+uint64_t merge_accs(const uint64_t* acc, uint64_t start) {
+    auto secret = default_secret + 11;
+    auto res = start;
+    for (size_t i = 0; i < 4; i++) {
+        res += mul128_fold64(acc[2 * i] ^ read_le64(secret + 16 * i),
+                acc[2 * i + 1] ^ read_le64(secret + 16 * i + 8));
+    }
+    return avalanche(res);
+}
+
+} // namespace
+
+uint64_t xxh3_64(const char* data, size_t len) {
+    auto input = reinterpret_cast<const uint8_t*>(data);
+    if (len <= midsize_max) {
+        return hash_short(input, len);
+    }
+    auto& kers = dispatch();
+    alignas(32) uint64_t acc[8];
+    init_acc(acc);
+    size_t blocks = (len - 1) / block_len;
+    for (size_t b = 0; b < blocks; b++) {
+        kers.accumulate(acc, input + b * block_len, default_secret, stripes_per_block);
+        kers.scramble(acc, default_secret + secret_size - stripe_len);
+    }
+    // last partial block, the last stripe always overlaps
+    size_t stripes = ((len - 1) - block_len * blocks) / stripe_len;
+    kers.accumulate(acc, input + blocks * block_len, default_secret, stripes);
+    kers.accumulate(acc, input + len - stripe_len, default_secret + secret_size - stripe_len - 7, 1);
+    return merge_accs(acc, len * prime64_1);
+}
+
+xxh3_state::xxh3_state() :
+buffered(0),
+stripes_in_block(0),
+total(0) {
+    init_acc(acc);
+    std::memset(buf, 0, sizeof(buf));
+}
+
+void xxh3_state::update(const char* data, size_t len) {
+    total += len;
+    if (buffered + len <= sizeof(buf)) {
+        std::memcpy(buf + buffered, data, len);
+        buffered += len;
+        return;
+    }
+    // at least one byte is always left buffered for digest
+    if (buffered > 0) {
+        auto fill = sizeof(buf) - buffered;
+        std::memcpy(buf + buffered, data, fill);
+        data += fill;
+        len -= fill;
+        consume_stripes(acc, stripes_in_block, buf, sizeof(buf) / stripe_len);
+        buffered = 0;
+    }
+    if (len > sizeof(buf)) {
+        auto nb_stripes = (len - 1) / stripe_len;
+        consume_stripes(acc, stripes_in_block, data, nb_stripes);
+        data += nb_stripes * stripe_len;
+        len -= nb_stripes * stripe_len;
+        std::memcpy(buf + sizeof(buf) - stripe_len, data - stripe_len, stripe_len);
+    }
+    std::memcpy(buf, data, len);
+    buffered = len;
+}
+
+uint64_t xxh3_state::digest() const {
+    if (total <= midsize_max) {
+        return hash_short(reinterpret_cast<const uint8_t*>(buf), static_cast<size_t>(total));
+    }
+    alignas(32) uint64_t accs[8];
+    std::memcpy(accs, acc, sizeof(accs));
+    alignas(32) char last_stripe[stripe_len];
+    const char* last_ptr = nullptr;
+    if (buffered >= stripe_len) {
+        auto count = stripes_in_block;
+        consume_stripes(accs, count, buf, (buffered - 1) / stripe_len);
+        last_ptr = buf + buffered - stripe_len;
+    } else {
+        // tail of the previously consumed data followed by buffered bytes
+        auto catchup = stripe_len - buffered;
+        std::memcpy(last_stripe, buf + sizeof(buf) - catchup, catchup);
+        std::memcpy(last_stripe + catchup, buf, buffered);
+        last_ptr = last_stripe;
+    }
+    dispatch().accumulate(accs, reinterpret_cast<const uint8_t*>(last_ptr),
+            default_secret + secret_size - stripe_len - 7, 1);
+    return merge_accs(accs, total * prime64_1);
+}
+
+void xxh3_state::consume_stripes(uint64_t* accs, size_t& stripes_count, const char* data,
+        size_t nb_stripes) const {
+    auto& kers = dispatch();
+    auto input = reinterpret_cast<const uint8_t*>(data);
+    while (nb_stripes > 0) {
+        auto count = std::min(nb_stripes, stripes_per_block - stripes_count);
+        kers.accumulate(accs, input, default_secret + stripes_count * 8, count);
+        stripes_count += count;
+        input += count * stripe_len;
+        nb_stripes -= count;
+        if (stripes_per_block == stripes_count) {
+            kers.scramble(accs, default_secret + secret_size - stripe_len);
+            stripes_count = 0;
+        }
+    }
+}
+
+} // namespace
+}
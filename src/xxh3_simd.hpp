@@ -0,0 +1,69 @@
+/*
+ * Copyright 2026, alex at staticlibs.net
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * File:   xxh3_simd.hpp
+ * Author: alex
+ *
+ * Created on October 16, 2026
+ */
+
+#ifndef WILTON_FS_XXH3_SIMD_HPP
+#define WILTON_FS_XXH3_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace wilton {
+namespace fs {
+
+/**
+ * One-shot XXH3 64-bit hash with default secret and zero seed
+ *
+ * @param data input bytes
+ * @param len input length
+ * @return hash value
+ */
+uint64_t xxh3_64(const char* data, size_t len);
+
+/**
+ * Streaming XXH3 64-bit hash, produces the same value as `xxh3_64`
+ * for the concatenated input; stripes are accumulated with SSE2
+ * on x86 with AVX2 runtime dispatch
+ */
+class xxh3_state {
+    alignas(32) uint64_t acc[8];
+    // last 64 bytes before the buffered tail are kept for the final stripe
+    alignas(32) char buf[256];
+    size_t buffered;
+    size_t stripes_in_block;
+    uint64_t total;
+
+public:
+    xxh3_state();
+
+    void update(const char* data, size_t len);
+
+    uint64_t digest() const;
+
+private:
+    void consume_stripes(uint64_t* accs, size_t& stripes_count, const char* data, size_t nb_stripes) const;
+};
+
+} // namespace
+}
+
+#endif /* WILTON_FS_XXH3_SIMD_HPP */